@@ -5,6 +5,7 @@
 #include "Kismet/KismetStringLibrary.h"
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "Core/ProjectCleanerDataManager.h"
+#include "Core/ProjectCleanerQuarantine.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogProjectCleanerCLI, Display, All);
 
@@ -28,6 +29,15 @@ int32 UProjectCleanerCLICommandlet::Main(const FString& Params)
 		return 1;
 	}
 	
+	if (IsArgumentsValid() && !RestoreQuarantineDir.IsEmpty())
+	{
+		FProjectCleanerDataManager CleanerDataManager;
+		CleanerDataManager.SetSilentMode(true);
+		UE_LOG(LogProjectCleanerCLI, Display, TEXT("Restored: %d files"), CleanerDataManager.RestoreQuarantine(RestoreQuarantineDir));
+		
+		return 0;
+	}
+	
 	if (IsArgumentsValid())
 	{
 		FProjectCleanerDataManager CleanerDataManager;
@@ -35,6 +45,17 @@ int32 UProjectCleanerCLICommandlet::Main(const FString& Params)
 		CleanerDataManager.SetUserExcludedAssets(ExcludedAssets);
 		CleanerDataManager.SetExcludePaths(ExcludedPaths);
 		CleanerDataManager.SetExcludeClasses(ExcludedClasses);
+		CleanerDataManager.SetForceSerialTraversal(bSerialTraversal);
+		CleanerDataManager.SetFollowedDependencyTypes(
+			FProjectCleanerDataManager::MakeFollowedDependencyTypes(
+				bFollowSoftReferences,
+				bFollowEditorOnlyReferences,
+				bFollowManagementReferences,
+				bFollowSearchableNameReferences
+			)
+		);
+		CleanerDataManager.SetDeleteWithoutLoading(bDeleteWithoutLoading);
+		CleanerDataManager.SetDeletionMemoryLimit(DeletionMemoryLimitMB);
 		CleanerDataManager.AnalyzeProject();
 		
 		UE_LOG(LogProjectCleanerCLI, Display, TEXT("===================================="));
@@ -46,13 +67,37 @@ int32 UProjectCleanerCLICommandlet::Main(const FString& Params)
 
 		if (bCheckOnly)
 		{
+			if (CleanerDataManager.HasInterruptedDeletion())
+			{
+				UE_LOG(LogProjectCleanerCLI, Warning, TEXT("Interrupted deletion found, run without -Check to resume it"));
+			}
+			
 			return 0;
 		}
+
+		// interrupted deletion can be resumed only by deleting, quarantining rest of it would mix deleted and restorable assets
+		if (bQuarantine && CleanerDataManager.HasInterruptedDeletion())
+		{
+			UE_LOG(LogProjectCleanerCLI, Error, TEXT("Interrupted deletion found, it can't be resumed with -Quarantine. Run without -Quarantine to resume it first"));
+			return 1;
+		}
 		
-		UE_LOG(LogProjectCleanerCLI, Display, TEXT("Deleted: %d assets"), CleanerDataManager.DeleteAllUnusedAssets());
+		if (CleanerDataManager.HasInterruptedDeletion())
+		{
+			UE_LOG(LogProjectCleanerCLI, Display, TEXT("Resumed interrupted deletion. Deleted: %d assets"), CleanerDataManager.ResumeInterruptedDeletion());
+		}
+		
+		if (bQuarantine)
+		{
+			UE_LOG(LogProjectCleanerCLI, Display, TEXT("Quarantined: %d assets"), CleanerDataManager.QuarantineAllUnusedAssets());
+		}
+		else
+		{
+			UE_LOG(LogProjectCleanerCLI, Display, TEXT("Deleted: %d assets"), CleanerDataManager.DeleteAllUnusedAssets());
+		}
 		if (bAutomaticallyDeleteEmptyFolders)
 		{
-			UE_LOG(LogProjectCleanerCLI, Display, TEXT("Deleted: %d empty folders"), CleanerDataManager.DeleteEmptyFolders());
+			UE_LOG(LogProjectCleanerCLI, Display, TEXT("Deleted: %d empty folders"), CleanerDataManager.DeleteEmptyFolders(false));
 		}
 		UE_LOG(LogProjectCleanerCLI, Display, TEXT("===================================="));
 		UE_LOG(LogProjectCleanerCLI, Display, TEXT("=========  After Cleanup    ========"));
@@ -76,6 +121,15 @@ void UProjectCleanerCLICommandlet::ParseCommandLinesArguments(const FString& Par
 	// -Check
 	// -ScanDevContent
 	// -DeleteEmptyFolders
+	// -SerialTraversal
+	// -IgnoreSoftReferences
+	// -IgnoreEditorOnlyReferences
+	// -FollowManagementReferences
+	// -FollowSearchableNameReferences
+	// -DeleteWithoutLoading
+	// -DeletionMemoryLimit=16384
+	// -Quarantine
+	// -RestoreQuarantine=Latest (or quarantine folder name)
 	// -ExcludeAssets= /Game/Blueprint/aaa.uasset
 	// -ExcludeAssetsInPath = /Game/Blueprint/
 	// -ExcludeAssetWithClass= UBlueprint,UMaterial
@@ -84,6 +138,15 @@ void UProjectCleanerCLICommandlet::ParseCommandLinesArguments(const FString& Par
 	// -Check - false
 	// -ScanDevContent - false
 	// -DeleteEmptyFolders - true
+	// -SerialTraversal - false
+	// -IgnoreSoftReferences - false
+	// -IgnoreEditorOnlyReferences - false
+	// -FollowManagementReferences - false
+	// -FollowSearchableNameReferences - false
+	// -DeleteWithoutLoading - false
+	// -DeletionMemoryLimit - 16384 MB
+	// -Quarantine - false
+	// -RestoreQuarantine - empty
 	// -ExcludeAssets - empty
 	// -ExcludeAssetsInPath - empty 
 	// -ExcludeAssetWithClass - empty
@@ -93,6 +156,15 @@ void UProjectCleanerCLICommandlet::ParseCommandLinesArguments(const FString& Par
 		bCheckOnly = false;
 		bScanDeveloperContents = false;
 		bAutomaticallyDeleteEmptyFolders = true;
+		bSerialTraversal = false;
+		bFollowSoftReferences = true;
+		bFollowEditorOnlyReferences = true;
+		bFollowManagementReferences = false;
+		bFollowSearchableNameReferences = false;
+		bDeleteWithoutLoading = false;
+		DeletionMemoryLimitMB = 16384;
+		bQuarantine = false;
+		RestoreQuarantineDir.Empty();
 		ExcludedAssets.Empty();
 		ExcludedPaths.Empty();
 		ExcludedClasses.Empty();
@@ -118,6 +190,41 @@ void UProjectCleanerCLICommandlet::ParseCommandLinesArguments(const FString& Par
 		{
 			bAutomaticallyDeleteEmptyFolders = true;
 		}
+
+		if (Switch.Equals(TEXT("SerialTraversal"), ESearchCase::IgnoreCase))
+		{
+			bSerialTraversal = true;
+		}
+
+		if (Switch.Equals(TEXT("IgnoreSoftReferences"), ESearchCase::IgnoreCase))
+		{
+			bFollowSoftReferences = false;
+		}
+
+		if (Switch.Equals(TEXT("IgnoreEditorOnlyReferences"), ESearchCase::IgnoreCase))
+		{
+			bFollowEditorOnlyReferences = false;
+		}
+
+		if (Switch.Equals(TEXT("FollowManagementReferences"), ESearchCase::IgnoreCase))
+		{
+			bFollowManagementReferences = true;
+		}
+
+		if (Switch.Equals(TEXT("FollowSearchableNameReferences"), ESearchCase::IgnoreCase))
+		{
+			bFollowSearchableNameReferences = true;
+		}
+
+		if (Switch.Equals(TEXT("DeleteWithoutLoading"), ESearchCase::IgnoreCase))
+		{
+			bDeleteWithoutLoading = true;
+		}
+
+		if (Switch.Equals(TEXT("Quarantine"), ESearchCase::IgnoreCase))
+		{
+			bQuarantine = true;
+		}
 	}
 	
 	FAssetRegistryModule& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(AssetRegistryConstants::ModuleName);
@@ -149,6 +256,18 @@ void UProjectCleanerCLICommandlet::ParseCommandLinesArguments(const FString& Par
 			}
 		}
 
+		if (Param.Key.Equals(TEXT("DeletionMemoryLimit"), ESearchCase::IgnoreCase))
+		{
+			DeletionMemoryLimitMB = FCString::Atoi(*Param.Value);
+		}
+
+		if (Param.Key.Equals(TEXT("RestoreQuarantine"), ESearchCase::IgnoreCase))
+		{
+			RestoreQuarantineDir = Param.Value.Equals(TEXT("Latest"), ESearchCase::IgnoreCase)
+				? FProjectCleanerQuarantine::GetLatestQuarantineDir()
+				: FProjectCleanerQuarantine::GetQuarantineRootDir() / Param.Value;
+		}
+
 		if (Param.Key.Equals(TEXT("ExcludeAssetsInPath"), ESearchCase::IgnoreCase))
 		{
 			// parsing string arguments to array
@@ -241,6 +360,15 @@ void UProjectCleanerCLICommandlet::ShowArgumentsInLog()
 	UE_LOG(LogProjectCleanerCLI, Display, TEXT("	Check [Just show information, no actions performed] - %s"), bCheckOnly ? TEXT("True") : TEXT("False"));
 	UE_LOG(LogProjectCleanerCLI, Display, TEXT("	ScanDevContent [Scan Developers Folder] - %s"), bScanDeveloperContents ? TEXT("True") : TEXT("False"));
 	UE_LOG(LogProjectCleanerCLI, Display, TEXT("	DeleteEmptyFolders [Automatically delete all empty folders after assets deleted] - %s"), bAutomaticallyDeleteEmptyFolders ? TEXT("True") : TEXT("False"));
+	UE_LOG(LogProjectCleanerCLI, Display, TEXT("	SerialTraversal [Search used assets on single thread, for verifying parallel search] - %s"), bSerialTraversal ? TEXT("True") : TEXT("False"));
+	UE_LOG(LogProjectCleanerCLI, Display, TEXT("	IgnoreSoftReferences [Assets referenced only by soft references are unused] - %s"), !bFollowSoftReferences ? TEXT("True") : TEXT("False"));
+	UE_LOG(LogProjectCleanerCLI, Display, TEXT("	IgnoreEditorOnlyReferences [Assets referenced only in editor are unused] - %s"), !bFollowEditorOnlyReferences ? TEXT("True") : TEXT("False"));
+	UE_LOG(LogProjectCleanerCLI, Display, TEXT("	FollowManagementReferences [Assets managed by primary assets are used] - %s"), bFollowManagementReferences ? TEXT("True") : TEXT("False"));
+	UE_LOG(LogProjectCleanerCLI, Display, TEXT("	FollowSearchableNameReferences [Assets referenced by searchable names are used] - %s"), bFollowSearchableNameReferences ? TEXT("True") : TEXT("False"));
+	UE_LOG(LogProjectCleanerCLI, Display, TEXT("	DeleteWithoutLoading [Delete package files of unloaded assets, without loading them] - %s"), bDeleteWithoutLoading ? TEXT("True") : TEXT("False"));
+	UE_LOG(LogProjectCleanerCLI, Display, TEXT("	DeletionMemoryLimit [Editor memory limit while deleting assets, MB] - %d"), DeletionMemoryLimitMB);
+	UE_LOG(LogProjectCleanerCLI, Display, TEXT("	Quarantine [Move unused assets to quarantine folder instead of deleting] - %s"), bQuarantine ? TEXT("True") : TEXT("False"));
+	UE_LOG(LogProjectCleanerCLI, Display, TEXT("	RestoreQuarantine [Restore assets from quarantine folder, no cleaning performed] - %s"), RestoreQuarantineDir.IsEmpty() ? TEXT("None") : *RestoreQuarantineDir);
 	UE_LOG(LogProjectCleanerCLI, Display, TEXT("	ExcludeAssets [Assets paths to exclude from scanning] - %s"), ExcludedAssets.Num() > 0 ? *UKismetStringLibrary::JoinStringArray(ExcludedAssets, TEXT(",")) : TEXT("[]"));
 	UE_LOG(LogProjectCleanerCLI, Display, TEXT("	ExcludeAssetsInPath [Paths to exclude from scanning] - %s"), ExcludedPaths.Num() > 0 ? *UKismetStringLibrary::JoinStringArray(ExcludedPaths, TEXT(",")) : TEXT("[]"));
 	UE_LOG(LogProjectCleanerCLI, Display, TEXT("	ExcludeAssetsWithClass [Asset Classes to exclude from scanning] - %s"), ExcludedClasses.Num() > 0 ? *UKismetStringLibrary::JoinStringArray(ExcludedClasses, TEXT(",")) : TEXT("[]"));
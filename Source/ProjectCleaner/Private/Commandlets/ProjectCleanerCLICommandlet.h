@@ -27,6 +27,15 @@ private:
 	bool bCheckOnly = false;
 	bool bScanDeveloperContents;
 	bool bAutomaticallyDeleteEmptyFolders;
+	bool bSerialTraversal = false;
+	bool bFollowSoftReferences = true;
+	bool bFollowEditorOnlyReferences = true;
+	bool bFollowManagementReferences = false;
+	bool bFollowSearchableNameReferences = false;
+	bool bDeleteWithoutLoading = false;
+	int32 DeletionMemoryLimitMB = 16384;
+	bool bQuarantine = false;
+	FString RestoreQuarantineDir;
 
 	TArray<FString> ExcludedAssets;
 	TArray<FString> ExcludedPaths;
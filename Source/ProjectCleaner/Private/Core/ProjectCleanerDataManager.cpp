@@ -3,7 +3,13 @@
 #include "Core/ProjectCleanerDataManager.h"
 #include "ProjectCleaner.h"
 #include "Core/ProjectCleanerUtility.h"
+#include "Core/ProjectCleanerDeletionJournal.h"
+#include "Core/ProjectCleanerDeletionPlanner.h"
+#include "Core/ProjectCleanerQuarantine.h"
+#include "Core/ProjectCleanerIndirectScanner.h"
 // Engine Headers
+#include "Algo/Reverse.h"
+#include "Async/ParallelFor.h"
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "AssetToolsModule.h"
 #include "AssetViewUtils.h"
@@ -13,18 +19,27 @@
 #include "Engine/AssetManagerSettings.h"
 #include "Engine/MapBuildDataRegistry.h"
 #include "Misc/Paths.h"
+#include "Misc/PackageName.h"
 #include "Misc/FileHelper.h"
 #include "Misc/ScopedSlowTask.h"
 #include "GenericPlatform/GenericPlatformFile.h"
 #include "HAL/PlatformFilemanager.h"
-#include "Internationalization/Regex.h"
 #include "Settings/ContentBrowserSettings.h"
+#include "ISourceControlModule.h"
+#include "SourceControlHelpers.h"
 
 FProjectCleanerDataManager::FProjectCleanerDataManager() :
 	bSilentMode(false),
 	bScanDeveloperContents(false),
 	bAutomaticallyDeleteEmptyFolders(true),
 	bCancelledByUser(false),
+	AllAssetsSize(0),
+	UnusedAssetsSize(0),
+	bIndirectCacheLoaded(false),
+	bForceSerialTraversal(false),
+	bDeleteWithoutLoading(false),
+	DeletionMemoryLimit(16384ll * 1024 * 1024),
+	FollowedDependencyTypes(EProjectCleanerDependencyType::Package),
 	AssetRegistry(nullptr),
 	AssetTools(nullptr),
 	PlatformFile(nullptr),
@@ -51,6 +66,8 @@ void FProjectCleanerDataManager::AnalyzeProject()
 	FixupRedirectors();
 	ProjectCleanerUtility::SaveAllAssets(!bSilentMode);
 	FindAllAssets();
+	BuildDependencyGraph();
+	ScanContentDirectory();
 	FindInvalidFilesAndAssets();
 	FindIndirectAssets();
 	FindEmptyFolders(bScanDeveloperContents);
@@ -66,8 +83,19 @@ void FProjectCleanerDataManager::PrintInfo()
 	UE_LOG(LogProjectCleaner, Display, TEXT("Corrupted Assets - %d"), CorruptedAssets.Num());
 	UE_LOG(LogProjectCleaner, Display, TEXT("Non Engine Files - %d"), NonEngineFiles.Num());
 	UE_LOG(LogProjectCleaner, Display, TEXT("IndirectAssets - %d"), IndirectAssets.Num());
+	UE_LOG(LogProjectCleaner, Display, TEXT("Editor Only Used Assets - %d"), EditorOnlyUsedAssets.Num());
 	UE_LOG(LogProjectCleaner, Display, TEXT("Empty Folders - %d"), EmptyFolders.Num());
 	UE_LOG(LogProjectCleaner, Display, TEXT("Excluded Assets - %d"), ExcludedAssets.Num());
+	UE_LOG(LogProjectCleaner, Display, TEXT("Followed Dependencies - %d of %d"), DependencyGraph.GetNumEdges(FollowedDependencyTypes), DependencyGraph.GetNumEdges());
+
+	for (const auto& Asset : LargestUnusedRoots)
+	{
+		UE_LOG(LogProjectCleaner, Display, TEXT("Unused Root - %s retains %s"), *Asset.PackageName.ToString(), *FText::AsMemory(GetRetainedSize(Asset)).ToString());
+	}
+	for (const auto& Asset : LargestUsedRoots)
+	{
+		UE_LOG(LogProjectCleaner, Display, TEXT("Used Root - %s retains %s"), *Asset.PackageName.ToString(), *FText::AsMemory(GetRetainedSize(Asset)).ToString());
+	}
 }
 
 void FProjectCleanerDataManager::SetExcludeClasses(const TArray<FString>& Classes)
@@ -185,7 +213,10 @@ bool FProjectCleanerDataManager::IncludePath(const FString& InPath)
 
 int32 FProjectCleanerDataManager::DeleteSelectedAssets(const TArray<FAssetData>& Assets)
 {
-	return ObjectTools::DeleteAssets(Assets);
+	const int32 DeletedAssetsNum = ObjectTools::DeleteAssets(Assets);
+	RemoveDeletedAssets(Assets);
+	
+	return DeletedAssetsNum;
 }
 
 int32 FProjectCleanerDataManager::DeleteAllUnusedAssets()
@@ -194,23 +225,96 @@ int32 FProjectCleanerDataManager::DeleteAllUnusedAssets()
 	{
 		AnalyzeProject();
 	}
+
+	return DeleteUnusedAssets(UnusedAssets);
+}
+
+bool FProjectCleanerDataManager::HasInterruptedDeletion() const
+{
+	return FProjectCleanerDeletionJournal::Exists();
+}
+
+int32 FProjectCleanerDataManager::ResumeInterruptedDeletion()
+{
+	TArray<FName> RemainingAssets;
+	if (!FProjectCleanerDeletionJournal::LoadRemainingAssets(RemainingAssets))
+	{
+		FProjectCleanerDeletionJournal::Discard();
+		return 0;
+	}
+
+	// project analyzed again after crash, so only assets that are still unused deleted
+	TSet<FName> UnusedAssetPaths;
+	UnusedAssetPaths.Reserve(UnusedAssets.Num());
+	for (const auto& Asset : UnusedAssets)
+	{
+		UnusedAssetPaths.Add(Asset.ObjectPath);
+	}
+	
+	TArray<FAssetData> Assets;
+	Assets.Reserve(RemainingAssets.Num());
+	for (const auto& ObjectPath : RemainingAssets)
+	{
+		if (!UnusedAssetPaths.Contains(ObjectPath)) continue;
+		
+		const FAssetData* Asset = FindAssetByPath(ObjectPath);
+		if (Asset)
+		{
+			Assets.Add(*Asset);
+		}
+	}
+
+	UE_LOG(LogProjectCleaner, Display, TEXT("Resuming interrupted deletion, %d of %d remaining assets still unused"), Assets.Num(), RemainingAssets.Num());
 	
-	constexpr int32 BucketSize = 500;
+	return DeleteUnusedAssets(Assets);
+}
+
+void FProjectCleanerDataManager::DiscardInterruptedDeletion()
+{
+	FProjectCleanerDeletionJournal::Discard();
+}
+
+int32 FProjectCleanerDataManager::DeleteUnusedAssets(const TArray<FAssetData>& Assets)
+{
+	// first bucket is small, next ones adapted by measured memory and time
+	int32 BucketSize = 100;
+	int32 BucketIndex = 0;
 	int32 DeletedAssetNum = 0;
-	const int32 Total = UnusedAssets.Num();
+	const int32 Total = Assets.Num();
+
+	// deletion order computed once, buckets just taken from it
+	FProjectCleanerDeletionPlanner DeletionPlanner;
+	DeletionPlanner.Build(DependencyGraph, Assets);
+
+	FProjectCleanerDeletionJournal DeletionJournal;
+	if (!DeletionJournal.Begin(DeletionPlanner.GetOrderedAssets()))
+	{
+		UE_LOG(LogProjectCleaner, Warning, TEXT("Failed to write deletion journal %s, deletion can't be resumed if interrupted"), *FProjectCleanerDeletionJournal::GetJournalFilePath());
+	}
 	
 	TArray<FAssetData> Bucket;
+	TArray<FAssetData> UnloadedAssets;
 	TArray<UObject*> LoadedAssets;
-	LoadedAssets.Reserve(BucketSize);
-	Bucket.Reserve(BucketSize);
+
+	// assets that can't go through fast delete path with their bucket, checked once more after all buckets
+	TSet<FName> PendingPackages;
+	TSet<FName> DeletedPackages;
+	TArray<FAssetData> DeferredAssets;
+	TArray<FAssetData> BlockedAssets;
+	TMap<FName, FName> BlockedPackages;
+	for (const auto& Asset : Assets)
+	{
+		PendingPackages.Add(Asset.PackageName);
+	}
+	bool bAborted = false;
 
 	FScopedSlowTask DeleteSlowTask(
-		UnusedAssets.Num(),
+		Assets.Num(),
 		FText::FromString(FStandardCleanerText::DeletingUnusedAssets)
 	);
 	DeleteSlowTask.MakeDialog(true);
 	
-	while (UnusedAssets.Num() > 0)
+	while (!DeletionPlanner.IsFinished())
 	{
 		if (DeleteSlowTask.ShouldCancel())
 		{
@@ -218,27 +322,95 @@ int32 FProjectCleanerDataManager::DeleteAllUnusedAssets()
 			break;
 		}
 		
-		FillBucketWithAssets(Bucket,BucketSize);
+		DeletionPlanner.GetNextBucket(BucketSize, Bucket);
+		const int32 BucketNum = Bucket.Num();
+		const int32 DeletedBeforeBucket = DeletedAssetNum;
+		const double BucketStartTime = FPlatformTime::Seconds();
+		const int64 MemoryBeforeBucket = FPlatformMemory::GetStats().UsedPhysical;
+		int64 PeakMemory = MemoryBeforeBucket;
+
+		TArray<FAssetData> HeldAssets;
+		ValidateBucket(Bucket, PendingPackages, DeletedPackages, HeldAssets, BlockedPackages);
+		for (const auto& Asset : HeldAssets)
+		{
+			if (BlockedPackages.Contains(Asset.PackageName))
+			{
+				PendingPackages.Remove(Asset.PackageName);
+				BlockedAssets.Add(Asset);
+			}
+			else
+			{
+				DeferredAssets.Add(Asset);
+			}
+		}
 
-		if (Bucket.Num() == 0)
+		if (bDeleteWithoutLoading)
 		{
-			break;
+			FindAssetsToDeleteWithoutLoading(Bucket, UnloadedAssets);
+			DeletedAssetNum += DeletePackageFiles(UnloadedAssets);
 		}
 
-		if (!PrepareBucketForDeletion(Bucket, LoadedAssets))
+		if (Bucket.Num() > 0)
 		{
-			UE_LOG(LogProjectCleaner, Error, TEXT("Failed to load some assets. Aborting."))
-			break;
+			if (!PrepareBucketForDeletion(Bucket, LoadedAssets))
+			{
+				UE_LOG(LogProjectCleaner, Error, TEXT("Failed to load some assets. Aborting."))
+				bAborted = true;
+				break;
+			}
+
+			// loaded assets is where memory goes, so peak measured right before deletion
+			PeakMemory = FMath::Max<int64>(PeakMemory, FPlatformMemory::GetStats().UsedPhysical);
+			DeletedAssetNum += DeleteBucket(LoadedAssets);
+			LoadedAssets.Reset();
+		}
+
+		// deleted packages tracked, so next buckets know which referencers are gone
+		Bucket.Append(UnloadedAssets);
+		for (const auto& Asset : Bucket)
+		{
+			PendingPackages.Remove(Asset.PackageName);
+			if (!FPackageName::DoesPackageExist(Asset.PackageName.ToString()))
+			{
+				DeletedPackages.Add(Asset.PackageName);
+			}
+		}
+		UnloadedAssets.Reset();
+
+		int64 UsedMemory = FPlatformMemory::GetStats().UsedPhysical;
+		if (UsedMemory > DeletionMemoryLimit * 3 / 4)
+		{
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+			UsedMemory = FPlatformMemory::GetStats().UsedPhysical;
 		}
 
-		DeletedAssetNum += DeleteBucket(LoadedAssets);
+		const double BucketTime = FPlatformTime::Seconds() - BucketStartTime;
+		const int32 BucketDeleted = DeletedAssetNum - DeletedBeforeBucket;
+		UE_LOG(
+			LogProjectCleaner,
+			Display,
+			TEXT("Bucket %d: deleted %d of %d assets in %.2f s (%.1f assets/s), memory used %lld MB"),
+			++BucketIndex,
+			BucketDeleted,
+			BucketNum,
+			BucketTime,
+			BucketTime > 0.0 ? BucketDeleted / BucketTime : 0.0,
+			UsedMemory / (1024 * 1024)
+		);
+		
+		BucketSize = GetNextBucketSize(BucketSize, BucketNum, PeakMemory - MemoryBeforeBucket, BucketTime, UsedMemory);
+		DeletionJournal.HoldAssets(HeldAssets);
+		DeletionJournal.CommitBucket(BucketNum);
+		
 		DeleteSlowTask.EnterProgressFrame(
-			Bucket.Num(),
+			BucketNum,
 			ProjectCleanerUtility::GetDeletionProgressText(DeletedAssetNum, Total, false)
 		);
-
-		Bucket.Reset();
-		LoadedAssets.Reset();
+	}
+	
+	if (!bCancelledByUser && !bAborted)
+	{
+		DeletedAssetNum += DeleteHeldAssets(DeferredAssets, BlockedAssets, BlockedPackages, PendingPackages, DeletedPackages, BucketSize, DeletionJournal, DeleteSlowTask, bAborted);
 	}
 	
 	// Cleaning empty packages
@@ -258,14 +430,108 @@ int32 FProjectCleanerDataManager::DeleteAllUnusedAssets()
 		ObjectTools::CleanupAfterSuccessfulDelete(AssetPackages);
 	}
 	
+	// cancelled or aborted deletion can be resumed later, so journal kept until plan finished
+	if (!bCancelledByUser && !bAborted)
+	{
+		DeletionJournal.Finish();
+	}
+	
+	RemoveDeletedAssets(Assets);
 	CleanupAfterDelete();
 
 	return DeletedAssetNum;
 }
 
+int32 FProjectCleanerDataManager::QuarantineAllUnusedAssets()
+{
+	if (bCancelledByUser)
+	{
+		AnalyzeProject();
+	}
+
+	FScopedSlowTask QuarantineSlowTask{
+		1.0f,
+		FText::FromString(FStandardCleanerText::QuarantiningUnusedAssets)
+	};
+	QuarantineSlowTask.MakeDialog();
+	QuarantineSlowTask.EnterProgressFrame();
+	
+	// files of loaded packages can't be moved safely, those assets must be deleted normally
+	TArray<FAssetData> LoadedAssets = UnusedAssets;
+	TArray<FAssetData> UnloadedAssets;
+	FindAssetsToDeleteWithoutLoading(LoadedAssets, UnloadedAssets);
+	if (LoadedAssets.Num() > 0)
+	{
+		UE_LOG(LogProjectCleaner, Warning, TEXT("%d unused assets are loaded or referenced by loaded assets, skipped"), LoadedAssets.Num());
+	}
+
+	// files moved without replacing references, so assets referenced by packages that stay in project (skipped loaded assets,
+	// references not followed by analysis) would leave dangling references. Everything moved at once, so nothing is pending
+	TArray<FAssetData> BlockedAssets;
+	TMap<FName, FName> BlockedPackages;
+	ValidateBucket(UnloadedAssets, TSet<FName>{}, TSet<FName>{}, BlockedAssets, BlockedPackages);
+	for (const auto& Asset : BlockedAssets)
+	{
+		const FName* Referencer = BlockedPackages.Find(Asset.PackageName);
+		UE_LOG(LogProjectCleaner, Warning, TEXT("%s referenced by %s, skipped"), *Asset.ObjectPath.ToString(), Referencer ? *Referencer->ToString() : TEXT("unknown"));
+	}
+	if (BlockedAssets.Num() > 0)
+	{
+		UE_LOG(LogProjectCleaner, Warning, TEXT("%d unused assets are referenced by assets that stay in project, skipped"), BlockedAssets.Num());
+	}
+
+	TArray<FString> Files;
+	GetPackageFiles(UnloadedAssets, Files);
+	
+	FString QuarantineDir;
+	const TArray<FString> MovedFiles = FProjectCleanerQuarantine::MoveToQuarantine(Files, QuarantineDir);
+	AssetRegistry->Get().ScanModifiedAssetFiles(MovedFiles);
+
+	const int32 QuarantinedAssetsNum = GetNumRemovedAssets(UnloadedAssets);
+	UE_LOG(LogProjectCleaner, Display, TEXT("Moved %d assets (%d files) to %s"), QuarantinedAssetsNum, MovedFiles.Num(), *QuarantineDir);
+	if (ISourceControlModule::Get().IsEnabled() && MovedFiles.Num() > 0)
+	{
+		UE_LOG(LogProjectCleaner, Warning, TEXT("Quarantined files are not marked for delete in source control, they reported as missing until restored or deleted there"));
+	}
+	
+	RemoveDeletedAssets(UnloadedAssets);
+	CleanupAfterDelete();
+
+	return QuarantinedAssetsNum;
+}
+
+int32 FProjectCleanerDataManager::RestoreQuarantine(const FString& QuarantineDir)
+{
+	if (QuarantineDir.IsEmpty() || !IFileManager::Get().DirectoryExists(*QuarantineDir))
+	{
+		UE_LOG(LogProjectCleaner, Error, TEXT("Quarantine folder %s not found"), *QuarantineDir);
+		return 0;
+	}
+	
+	const TArray<FString> RestoredFiles = FProjectCleanerQuarantine::Restore(QuarantineDir);
+	AssetRegistry->Get().ScanModifiedAssetFiles(RestoredFiles);
+	UE_LOG(LogProjectCleaner, Display, TEXT("Restored %d files from %s"), RestoredFiles.Num(), *QuarantineDir);
+	
+	// restored assets can be used by anything, so full analysis needed
+	AnalyzeProject();
+	CleanupAfterDelete();
+	
+	return RestoredFiles.Num();
+}
+
 int32 FProjectCleanerDataManager::DeleteEmptyFolders()
 {
-	FindEmptyFolders(bScanDeveloperContents);
+	return DeleteEmptyFolders(true);
+}
+
+int32 FProjectCleanerDataManager::DeleteEmptyFolders(const bool bRescanContent)
+{
+	// content could be changed outside of plugin since last analysis, so only right after deletion snapshot is trusted
+	if (bRescanContent)
+	{
+		ScanContentDirectory();
+		FindEmptyFolders(bScanDeveloperContents);
+	}
 	
 	if (EmptyFolders.Num() == 0)
 	{
@@ -288,6 +554,15 @@ int32 FProjectCleanerDataManager::DeleteEmptyFolders()
 		
 		if (!IFileManager::Get().DirectoryExists(*EmptyFolderStr)) continue;
 
+		// empty folders taken from snapshot, so making sure nothing added since then, folder deleted with all its content
+		TArray<FString> FolderFiles;
+		IFileManager::Get().FindFilesRecursive(FolderFiles, *EmptyFolderStr, TEXT("*"), true, false);
+		if (FolderFiles.Num() > 0)
+		{
+			UE_LOG(LogProjectCleaner, Warning, TEXT("%s folder is not empty anymore, skipped."), *EmptyFolderStr);
+			continue;
+		}
+
 		if (!IFileManager::Get().DeleteDirectory(*EmptyFolderStr, false, true))
 		{
 			UE_LOG(LogProjectCleaner, Error, TEXT("Failed to delete %s folder."), *EmptyFolderStr);
@@ -297,8 +572,15 @@ int32 FProjectCleanerDataManager::DeleteEmptyFolders()
 		++DeletedFoldersNum;
 		// removing folder path from asset registry
 		AssetRegistry->Get().RemovePath(ProjectCleanerUtility::ConvertAbsolutePathToInternal(EmptyFolderStr));
+
+		const int32 Directory = ContentSnapshot.FindDirectory(EmptyFolderStr);
+		if (Directory != INDEX_NONE)
+		{
+			ContentSnapshot.RemoveDirectory(Directory);
+		}
 	}
 
+	FindEmptyFolders(bScanDeveloperContents);
 	CleanupAfterDelete();
 
 	return DeletedFoldersNum;
@@ -334,11 +616,16 @@ const TSet<FName>& FProjectCleanerDataManager::GetNonEngineFiles() const
 	return NonEngineFiles;
 }
 
-const TMap<FAssetData, FIndirectAsset>& FProjectCleanerDataManager::GetIndirectAssets() const
+const FIndirectAssets& FProjectCleanerDataManager::GetIndirectAssets() const
 {
 	return IndirectAssets;
 }
 
+const TArray<FAssetData>& FProjectCleanerDataManager::GetEditorOnlyUsedAssets() const
+{
+	return EditorOnlyUsedAssets;
+}
+
 const TSet<FName>& FProjectCleanerDataManager::GetEmptyFolders() const
 {
 	return EmptyFolders;
@@ -349,6 +636,60 @@ const TSet<FName>& FProjectCleanerDataManager::GetPrimaryAssetClasses() const
 	return PrimaryAssetClasses;
 }
 
+int64 FProjectCleanerDataManager::GetAllAssetsSize() const
+{
+	return AllAssetsSize;
+}
+
+int64 FProjectCleanerDataManager::GetUnusedAssetsSize() const
+{
+	return UnusedAssetsSize;
+}
+
+int64 FProjectCleanerDataManager::GetRetainedSize(const FAssetData& Asset) const
+{
+	return DominatorTree.GetRetainedSize(DependencyGraph.FindNode(Asset.PackageName));
+}
+
+const TArray<FAssetData>& FProjectCleanerDataManager::GetLargestUnusedRoots() const
+{
+	return LargestUnusedRoots;
+}
+
+const TArray<FAssetData>& FProjectCleanerDataManager::GetLargestUsedRoots() const
+{
+	return LargestUsedRoots;
+}
+
+bool FProjectCleanerDataManager::GetUsageChain(const FAssetData& Asset, TArray<FName>& OutChain, EProjectCleanerUsedAssetRoot& OutRoot) const
+{
+	OutChain.Reset();
+	OutRoot = EProjectCleanerUsedAssetRoot::None;
+	
+	int32 Node = DependencyGraph.FindNode(Asset.PackageName);
+	if (Node == INDEX_NONE || !UsedNodeParents.IsValidIndex(Node)) return false;
+
+	// roots have no parent, but have reason, all other used nodes have parent
+	if (UsedNodeParents[Node] == INDEX_NONE && UsedNodeRoots[Node] == EProjectCleanerUsedAssetRoot::None) return false;
+	
+	while (UsedNodeParents[Node] != INDEX_NONE)
+	{
+		OutChain.Add(DependencyGraph.GetPackageName(Node));
+		Node = UsedNodeParents[Node];
+	}
+	OutChain.Add(DependencyGraph.GetPackageName(Node));
+	Algo::Reverse(OutChain);
+	
+	OutRoot = UsedNodeRoots[Node];
+	return true;
+}
+
+bool FProjectCleanerDataManager::IsAssetScanned(const FAssetData& Asset) const
+{
+	const int32 Node = DependencyGraph.FindNode(Asset.PackageName);
+	return Node != INDEX_NONE && DependencyGraph.IsGameNode(Node) && UsedNodeParents.IsValidIndex(Node) && !RemovedNodes[Node];
+}
+
 void FProjectCleanerDataManager::SetCleanerConfigs(const UCleanerConfigs* CleanerConfigs)
 {
 	if (!CleanerConfigs) return;
@@ -360,6 +701,15 @@ void FProjectCleanerDataManager::SetCleanerConfigs(const UCleanerConfigs* Cleane
 	Settings->PostEditChange();
 	
 	bAutomaticallyDeleteEmptyFolders = CleanerConfigs->bAutomaticallyDeleteEmptyFolders;
+	bDeleteWithoutLoading = CleanerConfigs->bDeleteWithoutLoading;
+	SetDeletionMemoryLimit(CleanerConfigs->DeletionMemoryLimitMB);
+
+	FollowedDependencyTypes = MakeFollowedDependencyTypes(
+		CleanerConfigs->bFollowSoftReferences,
+		CleanerConfigs->bFollowEditorOnlyReferences,
+		CleanerConfigs->bFollowManagementReferences,
+		CleanerConfigs->bFollowSearchableNameReferences
+	);
 
 	ExcludedPaths.Empty();
 	ExcludedClasses.Empty();
@@ -389,6 +739,54 @@ void FProjectCleanerDataManager::SetScanDeveloperContents(const bool bScan)
 	bScanDeveloperContents = bScan;
 }
 
+void FProjectCleanerDataManager::SetForceSerialTraversal(const bool bForceSerial)
+{
+	bForceSerialTraversal = bForceSerial;
+}
+
+void FProjectCleanerDataManager::SetFollowedDependencyTypes(const EProjectCleanerDependencyType DependencyTypes)
+{
+	FollowedDependencyTypes = DependencyTypes;
+}
+
+EProjectCleanerDependencyType FProjectCleanerDataManager::MakeFollowedDependencyTypes(const bool bSoft, const bool bEditorOnly, const bool bManagement, const bool bSearchableName)
+{
+	// hard references always followed
+	EProjectCleanerDependencyType DependencyTypes = EProjectCleanerDependencyType::Hard;
+	if (bSoft)
+	{
+		DependencyTypes |= EProjectCleanerDependencyType::Soft;
+	}
+	if (bEditorOnly)
+	{
+		DependencyTypes |= EProjectCleanerDependencyType::EditorOnlyHard;
+		if (bSoft)
+		{
+			DependencyTypes |= EProjectCleanerDependencyType::EditorOnlySoft;
+		}
+	}
+	if (bManagement)
+	{
+		DependencyTypes |= EProjectCleanerDependencyType::Management;
+	}
+	if (bSearchableName)
+	{
+		DependencyTypes |= EProjectCleanerDependencyType::SearchableName;
+	}
+
+	return DependencyTypes;
+}
+
+void FProjectCleanerDataManager::SetDeleteWithoutLoading(const bool bWithoutLoading)
+{
+	bDeleteWithoutLoading = bWithoutLoading;
+}
+
+void FProjectCleanerDataManager::SetDeletionMemoryLimit(const int32 MemoryLimitMB)
+{
+	DeletionMemoryLimit = static_cast<int64>(FMath::Max(MemoryLimitMB, 1024)) * 1024 * 1024;
+}
+
 // PRIVATE Functions
 void FProjectCleanerDataManager::FixupRedirectors() const
 {
@@ -445,70 +843,124 @@ void FProjectCleanerDataManager::FindAllAssets()
 	AllAssets.Empty();
 	AllAssets.Reserve(AssetRegistry->Get().GetAllocatedSize());
 	AssetRegistry->Get().GetAssetsByPath(RelativeRoot, AllAssets, true);
+
+	// building lookup index once, so all later searches by path are O(1) instead of linear scans over AllAssets
+	// object paths always contain '.' and package names never do, so both can share same map
+	AssetIndexByPath.Empty(AllAssets.Num() * 2);
+	for (int32 Index = 0; Index < AllAssets.Num(); ++Index)
+	{
+		AssetIndexByPath.Add(AllAssets[Index].ObjectPath, Index);
+		AssetIndexByPath.Add(AllAssets[Index].PackageName, Index);
+	}
+}
+
+void FProjectCleanerDataManager::BuildDependencyGraph()
+{
+	TArray<FName> PackageNames;
+	PackageNames.Reserve(AllAssets.Num());
+	for (const auto& Asset : AllAssets)
+	{
+		PackageNames.Add(Asset.PackageName);
+	}
+
+	DependencyGraph.Build(AssetRegistry->Get(), PackageNames);
+	RemovedNodes.Init(false, DependencyGraph.GetNumNodes());
+
+	// followed types only change result if graph has edges of them, otherwise option silently does nothing
+	const int32 NumManagementEdges = DependencyGraph.GetNumEdges(EProjectCleanerDependencyType::Management);
+	const int32 NumSearchableNameEdges = DependencyGraph.GetNumEdges(EProjectCleanerDependencyType::SearchableName);
+	UE_LOG(
+		LogProjectCleaner,
+		Display,
+		TEXT("Dependency graph: %d nodes, %d edges (%d package, %d management, %d searchable name), %d followed"),
+		DependencyGraph.GetNumNodes(),
+		DependencyGraph.GetNumEdges(),
+		DependencyGraph.GetNumEdges(EProjectCleanerDependencyType::Package),
+		NumManagementEdges,
+		NumSearchableNameEdges,
+		DependencyGraph.GetNumEdges(FollowedDependencyTypes)
+	);
+	if (EnumHasAnyFlags(FollowedDependencyTypes, EProjectCleanerDependencyType::Management) && NumManagementEdges == 0)
+	{
+		UE_LOG(LogProjectCleaner, Warning, TEXT("Management references followed, but no management edges found"));
+	}
+	if (EnumHasAnyFlags(FollowedDependencyTypes, EProjectCleanerDependencyType::SearchableName) && NumSearchableNameEdges == 0)
+	{
+		UE_LOG(LogProjectCleaner, Warning, TEXT("Searchable name references followed, but no searchable name edges found"));
+	}
+
+	AssetNodes.SetNumUninitialized(AllAssets.Num());
+	for (int32 Index = 0; Index < AllAssets.Num(); ++Index)
+	{
+		AssetNodes[Index] = DependencyGraph.FindNode(AllAssets[Index].PackageName);
+	}
+}
+
+void FProjectCleanerDataManager::ScanContentDirectory()
+{
+	ContentSnapshot.Build(FPaths::ConvertRelativePathToFull(FPaths::ProjectContentDir()));
 }
 
 void FProjectCleanerDataManager::FindInvalidFilesAndAssets()
 {
 	CorruptedAssets.Empty();
 	NonEngineFiles.Empty();
+	PackageDiskSizes.Empty();
 
-	struct ProjectCleanerDirVisitor : IPlatformFile::FDirectoryVisitor
+	const TArray<FProjectCleanerFileEntry>& Files = ContentSnapshot.GetFiles();
+	const FString& ContentDir = ContentSnapshot.GetRootDir();
+	const FString RelativeRootPath = RelativeRoot.ToString();
+
+	// per file results, filled in parallel. Non engine files keep NAME_None
+	TArray<FName> FilesPackageNames;
+	TArray<FName> FilesObjectPaths;
+	FilesPackageNames.SetNum(Files.Num());
+	FilesObjectPaths.SetNum(Files.Num());
+
+	ParallelFor(Files.Num(), [&](const int32 Index)
 	{
-		ProjectCleanerDirVisitor(
-			const TArray<FAssetData>& Assets,
-			TSet<FName>& NewCorruptedAssets,
-			TSet<FName>& NewNonEngineFiles
-		) :
-		AllAssets(Assets),
-		CorruptedAssets(NewCorruptedAssets),
-		NonEngineFiles(NewNonEngineFiles) {}
+		const FString& FilePath = Files[Index].Path;
+		const FString Extension = FPaths::GetExtension(FilePath, false);
+		if (!ProjectCleanerUtility::IsEngineExtension(Extension)) return;
+
+		// converting absolute file path to package and object paths (This is for searching in AssetRegistry)
+		// example "C:/MyProject/Content/Maps/Name.umap" => "/Game/Maps/Name" and "/Game/Maps/Name.Name"
+		const int32 RelativePathLen = FilePath.Len() - ContentDir.Len() - Extension.Len() - 1;
+		const int32 BaseNameStart = FilePath.Find(TEXT("/"), ESearchCase::CaseSensitive, ESearchDir::FromEnd) + 1;
+
+		FString ObjectPath;
+		ObjectPath.Reserve(RelativeRootPath.Len() + FilePath.Len());
+		ObjectPath.Append(RelativeRootPath);
+		ObjectPath.AppendChars(*FilePath + ContentDir.Len(), RelativePathLen);
+		FilesPackageNames[Index] = FName{*ObjectPath};
 		
-		virtual bool Visit(const TCHAR* FilenameOrDirectory, bool bIsDirectory) override
+		ObjectPath.AppendChar(TEXT('.'));
+		ObjectPath.AppendChars(*FilePath + BaseNameStart, FilePath.Len() - BaseNameStart - Extension.Len() - 1);
+		FilesObjectPaths[Index] = FName{*ObjectPath};
+	});
+
+	for (int32 Index = 0; Index < Files.Num(); ++Index)
+	{
+		if (FilesObjectPaths[Index].IsNone())
 		{
-			const FString FullPath = FPaths::ConvertRelativePathToFull(FilenameOrDirectory);
-			if (!bIsDirectory)
-			{
-				if (ProjectCleanerUtility::IsEngineExtension(FPaths::GetExtension(FullPath, false)))
-				{
-					// here we got absolute path "C:/MyProject/Content/material.uasset"
-					// we must first convert that path to In Engine Internal Path like "/Game/material.uasset"
-					const FString InternalFilePath = ProjectCleanerUtility::ConvertAbsolutePathToInternal(FullPath);
-					// Converting file path to object path (This is for searching in AssetRegistry)
-					// example "/Game/Name.uasset" => "/Game/Name.Name"
-					FString ObjectPath = InternalFilePath;
-					ObjectPath.RemoveFromEnd(FPaths::GetExtension(InternalFilePath, true));
-					ObjectPath.Append(TEXT(".") + FPaths::GetBaseFilename(InternalFilePath));
-
-					const FName ObjectPathName = FName{*ObjectPath};
-					const bool IsInAssetRegistry = AllAssets.ContainsByPredicate([&] (const FAssetData& Elem)
-					{
-						return Elem.ObjectPath.IsEqual(ObjectPathName);
-					});
-					if (!IsInAssetRegistry)
-					{
-						CorruptedAssets.Add(ObjectPathName);
-					}
-				}
-				else
-				{
-					NonEngineFiles.Add(FName{FullPath});
-				}
-			}
+			NonEngineFiles.Add(FName{*Files[Index].Path});
+			continue;
+		}
 
-			return true;
+		PackageDiskSizes.Add(FilesPackageNames[Index], Files[Index].Size);
+		
+		if (!AssetIndexByPath.Contains(FilesObjectPaths[Index]))
+		{
+			CorruptedAssets.Add(FilesObjectPaths[Index]);
 		}
-		const TArray<FAssetData>& AllAssets;
-		TSet<FName>& CorruptedAssets;
-		TSet<FName>& NonEngineFiles;
-	};
+	}
 
-	ProjectCleanerDirVisitor Visitor{AllAssets, CorruptedAssets, NonEngineFiles};
-	FPlatformFileManager::Get().GetPlatformFile().IterateDirectoryRecursively(*FPaths::ProjectContentDir(), Visitor);
+	AllAssetsSize = GetTotalSize(AllAssets);
 }
 
 void FProjectCleanerDataManager::FindIndirectAssets()
 {
-	IndirectAssets.Empty();
+	IndirectAssets.Reset();
 	
 	const FString SourceDir = FPaths::ProjectDir() + TEXT("Source/");
 	const FString ConfigDir = FPaths::ProjectDir() + TEXT("Config/");
@@ -559,96 +1011,112 @@ void FProjectCleanerDataManager::FindIndirectAssets()
 	}
 	
 	Files.Append(ProjectPluginsFiles);
-	Files.Shrink();
 
-	for (const auto& File : Files)
+	// 4) scanning files in parallel, every file gets its own result slot, so workers never share state
+	// unchanged files are taken from cache, without reading them
+	if (!bIndirectCacheLoaded)
 	{
-		if (!PlatformFile->FileExists(*File)) continue;
+		IndirectCache.Load(FProjectCleanerIndirectCache::GetDefaultCacheFilePath());
+		bIndirectCacheLoaded = true;
+	}
 	
-		FString FileContent;
-		FFileHelper::LoadFileToString(FileContent, *File);
-		
-		if (!ProjectCleanerUtility::HasIndirectlyUsedAssets(FileContent)) continue;
+	TArray<FString> SortedFiles = Files.Array();
+	SortedFiles.Sort();
 
-		static FRegexPattern Pattern(TEXT(R"(\/Game(.*)\b)"));
-		FRegexMatcher Matcher(Pattern, FileContent);
-		while (Matcher.FindNext())
+	TArray<FProjectCleanerIndirectCacheEntry> FileEntries;
+	FileEntries.SetNum(SortedFiles.Num());
+
+	ParallelFor(SortedFiles.Num(), [&](const int32 Index)
+	{
+		// files that can't be read are marked, so they are not cached
+		if (!IndirectCache.ScanFile(SortedFiles[Index], FileEntries[Index]))
+		{
+			FileEntries[Index].Size = INDEX_NONE;
+		}
+	});
+
+	// 5) merging in file order, so results does not depend on thread scheduling
+	for (int32 FileIndex = 0; FileIndex < SortedFiles.Num(); ++FileIndex)
+	{
+		// file path stored only once, when first asset usage found in it
+		int32 InternedFileIndex = INDEX_NONE;
+		
+		for (const auto& Reference : FileEntries[FileIndex].References)
 		{
-			FName FoundedAssetObjectPath =  FName{Matcher.GetCaptureGroup(0)};
-			if (!FoundedAssetObjectPath.IsValid()) continue;
+			const int32 AssetIndex = FindAssetIndexByIndirectReference(Reference.Path);
+			if (AssetIndex == INDEX_NONE) continue;
 
-			// if ObjectPath ends with "_C" , then its probably blueprint, so we trim that
-			if (FoundedAssetObjectPath.ToString().EndsWith("_C"))
+			if (InternedFileIndex == INDEX_NONE)
 			{
-				FString TrimmedObjectPath = FoundedAssetObjectPath.ToString();
-				TrimmedObjectPath.RemoveFromEnd("_C");
-				
-				FoundedAssetObjectPath = FName{*TrimmedObjectPath};
+				InternedFileIndex = IndirectAssets.Files.Add(FPaths::ConvertRelativePathToFull(SortedFiles[FileIndex]));
 			}
-			const FAssetData* AssetData = AllAssets.FindByPredicate([&] (const FAssetData& Elem)
-			{
-				return
-					Elem.ObjectPath.IsEqual(FoundedAssetObjectPath) ||
-					Elem.PackageName.IsEqual(FoundedAssetObjectPath);
-			});
 
-			if (!AssetData) continue;
-			
-			// if founded asset is ok, we loading file by lines to determine on what line its used
-			TArray<FString> Lines;
-			FFileHelper::LoadFileToStringArray(Lines, *File);
-			for (int32 i = 0; i < Lines.Num(); ++i)
-			{
-				if (!Lines.IsValidIndex(i)) continue;
-				if (!Lines[i].Contains(FoundedAssetObjectPath.ToString())) continue;
+			// same asset can be mentioned multiple times in single line
+			TArray<FIndirectAssetUsage>& Usages = IndirectAssets.Usages.FindOrAdd(AssetIndex);
+			const FIndirectAssetUsage Usage{InternedFileIndex, Reference.Line};
+			if (Usages.Num() > 0 && Usages.Last() == Usage) continue;
 			
-				FIndirectAsset IndirectAsset;
-				IndirectAsset.File = FPaths::ConvertRelativePathToFull(File);
-				IndirectAsset.RelativePath = AssetData->PackagePath;
-				IndirectAsset.Line = i + 1;
-				IndirectAssets.Add(*AssetData, IndirectAsset);
-			}
+			Usages.Add(Usage);
 		}
 	}
+
+	// 6) rebuilding cache from current files only, so removed files does not stay in cache forever
+	IndirectCache.Reset();
+	for (int32 FileIndex = 0; FileIndex < SortedFiles.Num(); ++FileIndex)
+	{
+		if (FileEntries[FileIndex].Size == INDEX_NONE) continue;
+		
+		IndirectCache.Add(SortedFiles[FileIndex], MoveTemp(FileEntries[FileIndex]));
+	}
+	IndirectCache.Save(FProjectCleanerIndirectCache::GetDefaultCacheFilePath());
 }
 
 void FProjectCleanerDataManager::FindEmptyFolders(const bool bScanDevelopersContent)
 {
 	EmptyFolders.Empty();
-	
-	ProjectCleanerUtility::FindEmptyFoldersInPath(FPaths::ProjectContentDir() / TEXT("*"), EmptyFolders);
 
-	const FString CollectionsFolder = FPaths::ProjectContentDir() + TEXT("Collections/");
-	const FString DevelopersFolder = FPaths::ProjectContentDir() + TEXT("Developers/");
-	const FString UserDir = DevelopersFolder + FPaths::GameUserDeveloperFolderName() + TEXT("/");
-	const FString UserCollectionsDir = UserDir + TEXT("Collections/");
-	
-	EmptyFolders.Remove(FName{*CollectionsFolder});
-	EmptyFolders.Remove(FName{*DevelopersFolder});
-	EmptyFolders.Remove(FName{*UserDir});
-	EmptyFolders.Remove(FName{*UserCollectionsDir});
+	const TArray<FProjectCleanerDirectoryEntry>& Directories = ContentSnapshot.GetDirectories();
+	if (Directories.Num() == 0) return;
 
-	if (!bScanDevelopersContent)
+	const FString ContentDir = ContentSnapshot.GetRootDir();
+	const int32 CollectionsFolder = ContentSnapshot.FindDirectory(ContentDir / TEXT("Collections"));
+	const int32 DevelopersFolder = ContentSnapshot.FindDirectory(ContentDir / TEXT("Developers"));
+	const int32 UserDir = ContentSnapshot.FindDirectory(ContentDir / TEXT("Developers") / FPaths::GameUserDeveloperFolderName());
+	const int32 UserCollectionsDir = ContentSnapshot.FindDirectory(ContentDir / TEXT("Developers") / FPaths::GameUserDeveloperFolderName() / TEXT("Collections"));
+
+	// those folders are managed by engine, so we never treat them as empty
+	TBitArray<> ExcludedFolders{false, Directories.Num()};
+	for (const int32 Folder : {CollectionsFolder, DevelopersFolder, UserDir, UserCollectionsDir})
 	{
-		// find all folders that are under developer folders
-		TSet<FName> FilteredFolders;
-		FilteredFolders.Reserve(EmptyFolders.Num());
+		if (Folder == INDEX_NONE) continue;
+		ExcludedFolders[Folder] = true;
+	}
 
-		for (const auto& Folder : EmptyFolders)
+	// if developers content not scanned, then whole Collections and Developers folders with all subfolders excluded
+	TBitArray<> ExcludedSubtrees{false, Directories.Num()};
+	if (!bScanDevelopersContent)
+	{
+		for (const int32 Folder : {CollectionsFolder, DevelopersFolder})
 		{
-			if (
-				FPaths::IsUnderDirectory(Folder.ToString(), CollectionsFolder) ||
-				FPaths::IsUnderDirectory(Folder.ToString(), DevelopersFolder)
-			)
-			{
-				FilteredFolders.Add(Folder);
-			}
+			if (Folder == INDEX_NONE) continue;
+			ExcludedSubtrees[Folder] = true;
 		}
+	}
 
-		for (const auto& Folder : FilteredFolders)
+	// parent always placed before its children, so subtree state already known when visiting child
+	// root directory itself never considered as empty folder
+	for (int32 Index = 1; Index < Directories.Num(); ++Index)
+	{
+		const FProjectCleanerDirectoryEntry& Directory = Directories[Index];
+		if (ExcludedSubtrees[Directory.ParentIndex])
 		{
-			EmptyFolders.Remove(Folder);
+			ExcludedSubtrees[Index] = true;
 		}
+
+		if (Directory.NumFilesRecursive > 0 || Directory.bRemoved) continue;
+		if (ExcludedFolders[Index] || ExcludedSubtrees[Index]) continue;
+
+		EmptyFolders.Add(FName{*(Directory.Path + TEXT("/"))});
 	}
 }
 
@@ -673,25 +1141,8 @@ void FProjectCleanerDataManager::FindPrimaryAssetClasses()
 
 void FProjectCleanerDataManager::FindAssetsWithExternalReferencers()
 {
-	AssetsWithExternalRefs.Empty();
-	TArray<FName> Refs;
-	for (const auto& Asset : AllAssets)
-	{
-		AssetRegistry->Get().GetReferencers(Asset.PackageName, Refs);
-
-		const bool HasExternalRefs = Refs.ContainsByPredicate([](const FName& Ref)
-		{
-			return !Ref.ToString().StartsWith(TEXT("/Game"));
-		});
-
-		if (HasExternalRefs)
-		{
-			AssetsWithExternalRefs.AddUnique(Asset);
-		}
-
-		Refs.Reset();
-	}
-}
+	DependencyGraph.FindNodesWithExternalReferencers(NodesWithExternalRefs, FollowedDependencyTypes);
+}
 
 void FProjectCleanerDataManager::FindUnusedAssets()
 {
@@ -700,6 +1151,8 @@ void FProjectCleanerDataManager::FindUnusedAssets()
 	ExcludedAssets.Empty();
 	ExcludedAssets.Reserve(AllAssets.Num());
 
+	UsedNodeRoots.Init(EProjectCleanerUsedAssetRoot::None, DependencyGraph.GetNumNodes());
+	
 	TSet<FName> UsedAssets;
 	UsedAssets.Reserve(AllAssets.Num());
 	FindUsedAssets(UsedAssets);
@@ -707,20 +1160,126 @@ void FProjectCleanerDataManager::FindUnusedAssets()
 
 	FindExcludedAssets(UsedAssets);
 
-	TSet<FName> UsedAssetsDependencies;
-	UsedAssetsDependencies.Reserve(AllAssets.Num());
-	FindUsedAssetsDependencies(UsedAssets, UsedAssetsDependencies);
+	TBitArray<> UsedNodes;
+	FindUsedAssetsDependencies(UsedAssets, UsedNodes);
 
+	// primary assets are part of used assets, so everything not reached is unused
 	const bool IsMegascansLoaded = FModuleManager::Get().IsModuleLoaded("MegascansPlugin");
-	for (const auto& Asset : AllAssets)
+	for (int32 Index = 0; Index < AllAssets.Num(); ++Index)
 	{
-		if (UsedAssetsDependencies.Contains(Asset.PackageName)) continue;
-		if (PrimaryAssets.Contains(Asset)) continue;
-		if (IsMegascansLoaded && ProjectCleanerUtility::IsUnderMegascansFolder(Asset)) continue;
+		if (UsedNodes[AssetNodes[Index]]) continue;
+		if (IsMegascansLoaded && ProjectCleanerUtility::IsUnderMegascansFolder(AllAssets[Index])) continue;
 		
-		UnusedAssets.Add(Asset);
+		UnusedAssets.Add(AllAssets[Index]);
 	}
 	UnusedAssets.Shrink();
+
+	FindEditorOnlyUsedAssets(UsedAssets, UsedNodes);
+	FindRetainedSizes(UsedAssets, UsedNodes);
+
+	UnusedAssetsSize = GetTotalSize(UnusedAssets);
+}
+
+void FProjectCleanerDataManager::FindEditorOnlyUsedAssets(const TSet<FName>& UsedAssets, const TBitArray<>& UsedNodes)
+{
+	EditorOnlyUsedAssets.Reset();
+	if (!EnumHasAnyFlags(FollowedDependencyTypes, EProjectCleanerDependencyType::EditorOnly)) return;
+
+	TArray<int32> Roots;
+	Roots.Reserve(UsedAssets.Num());
+	for (const auto& Asset : UsedAssets)
+	{
+		const int32 Node = DependencyGraph.FindNode(Asset);
+		if (Node != INDEX_NONE)
+		{
+			Roots.Add(Node);
+		}
+	}
+
+	// same search without editor only edges, everything that is not reached anymore used only by editor
+	TBitArray<> GameUsedNodes;
+	DependencyGraph.FindReachableNodes(Roots, GameUsedNodes, FollowedDependencyTypes & ~EProjectCleanerDependencyType::EditorOnly, bForceSerialTraversal);
+
+	for (int32 Index = 0; Index < AllAssets.Num(); ++Index)
+	{
+		const int32 Node = AssetNodes[Index];
+		if (UsedNodes[Node] && !GameUsedNodes[Node])
+		{
+			EditorOnlyUsedAssets.Add(AllAssets[Index]);
+		}
+	}
+}
+
+void FProjectCleanerDataManager::FindRetainedSizes(const TSet<FName>& UsedAssets, const TBitArray<>& UsedNodes)
+{
+	constexpr int32 MaxLargestRoots = 10;
+	
+	LargestUnusedRoots.Reset();
+	LargestUsedRoots.Reset();
+
+	TArray<int32> Roots;
+	Roots.Reserve(UsedAssets.Num());
+	for (const auto& Asset : UsedAssets)
+	{
+		const int32 Node = DependencyGraph.FindNode(Asset);
+		if (Node != INDEX_NONE)
+		{
+			Roots.Add(Node);
+		}
+	}
+	// set iteration order is not stable, sorting roots so tree is same between runs
+	Roots.Sort();
+
+	TArray<int64> NodeSizes;
+	NodeSizes.SetNumZeroed(DependencyGraph.GetNumNodes());
+	for (const auto& PackageDiskSize : PackageDiskSizes)
+	{
+		const int32 Node = DependencyGraph.FindNode(PackageDiskSize.Key);
+		if (Node != INDEX_NONE)
+		{
+			NodeSizes[Node] = PackageDiskSize.Value;
+		}
+	}
+
+	// unused assets are not reachable from used ones, so they get their own roots inside tree
+	DominatorTree.Build(DependencyGraph, Roots, FollowedDependencyTypes, NodeSizes);
+
+	TSet<int32> AddedNodes;
+	for (int32 Index = 0; Index < AllAssets.Num(); ++Index)
+	{
+		const int32 Node = AssetNodes[Index];
+		if (!DominatorTree.IsInTree(Node) || DominatorTree.GetImmediateDominator(Node) != INDEX_NONE) continue;
+
+		// package can contain multiple assets, showing only one of them
+		bool bAlreadyAdded = false;
+		AddedNodes.Add(Node, &bAlreadyAdded);
+		if (bAlreadyAdded) continue;
+		
+		if (UsedNodes[Node])
+		{
+			LargestUsedRoots.Add(AllAssets[Index]);
+		}
+		else
+		{
+			LargestUnusedRoots.Add(AllAssets[Index]);
+		}
+	}
+
+	const auto SortAndTrim = [&](TArray<FAssetData>& Assets)
+	{
+		Assets.Sort([&](const FAssetData& AssetA, const FAssetData& AssetB)
+		{
+			return GetRetainedSize(AssetA) > GetRetainedSize(AssetB);
+		});
+		
+		if (Assets.Num() > MaxLargestRoots)
+		{
+			Assets.SetNum(MaxLargestRoots);
+		}
+	};
+	
+	SortAndTrim(LargestUnusedRoots);
+	SortAndTrim(LargestUsedRoots);
 }
 
 void FProjectCleanerDataManager::FindUsedAssets(TSet<FName>& UsedAssets)
@@ -745,7 +1304,7 @@ void FProjectCleanerDataManager::FindUsedAssets(TSet<FName>& UsedAssets)
 		const FName BP_ClassName = ProjectCleanerUtility::GetClassName(BP_Asset);
 		if (DerivedFromPrimaryAssets.Contains(BP_ClassName))
 		{
-			UsedAssets.Add(BP_Asset.PackageName);
+			MarkAsUsed(UsedAssets, BP_Asset.PackageName, EProjectCleanerUsedAssetRoot::PrimaryAsset);
 		}
 	}
 	
@@ -760,17 +1319,20 @@ void FProjectCleanerDataManager::FindUsedAssets(TSet<FName>& UsedAssets)
 
 	for (const auto& Asset : PrimaryAssets)
 	{
-		UsedAssets.Add(Asset.PackageName);
+		MarkAsUsed(UsedAssets, Asset.PackageName, EProjectCleanerUsedAssetRoot::PrimaryAsset);
 	}
 
-	for (const auto& Asset : IndirectAssets)
+	for (const auto& Usage : IndirectAssets.Usages)
 	{
-		UsedAssets.Add(Asset.Key.PackageName);
+		MarkAsUsed(UsedAssets, AllAssets[Usage.Key].PackageName, EProjectCleanerUsedAssetRoot::IndirectReference);
 	}
 
-	for (const auto& Asset : AssetsWithExternalRefs)
+	for (int32 Index = 0; Index < AllAssets.Num(); ++Index)
 	{
-		UsedAssets.Add(Asset.PackageName);
+		if (NodesWithExternalRefs[AssetNodes[Index]])
+		{
+			MarkAsUsed(UsedAssets, AllAssets[Index].PackageName, EProjectCleanerUsedAssetRoot::ExternalReferencer);
+		}
 	}
 
 	if (!bScanDeveloperContents)
@@ -780,43 +1342,26 @@ void FProjectCleanerDataManager::FindUsedAssets(TSet<FName>& UsedAssets)
 
 		for (const auto& Asset : AssetsInDeveloperFolder)
 		{
-			UsedAssets.Add(Asset.PackageName);
+			MarkAsUsed(UsedAssets, Asset.PackageName, EProjectCleanerUsedAssetRoot::DeveloperFolder);
 		}
 	}
 }
 
-void FProjectCleanerDataManager::FindUsedAssetsDependencies(const TSet<FName>& UsedAssets, TSet<FName>& UsedAssetsDeps) const
+void FProjectCleanerDataManager::FindUsedAssetsDependencies(const TSet<FName>& UsedAssets, TBitArray<>& UsedNodes)
 {
-	TArray<FName> Stack;
+	TArray<int32> Roots;
+	Roots.Reserve(UsedAssets.Num());
+	
 	for (const auto& Asset : UsedAssets)
 	{
-		UsedAssetsDeps.Add(Asset);
-		Stack.Add(Asset);
-
-		TArray<FName> Deps;
-		while (Stack.Num() > 0)
-		{
-			const auto CurrentPackageName = Stack.Pop(false);
-			Deps.Reset();
-
-			AssetRegistry->Get().GetDependencies(CurrentPackageName, Deps);
-
-			Deps.RemoveAllSwap([&] (const FName& Dep)
-			{
-				return !Dep.ToString().StartsWith(*RelativeRoot.ToString());
-			}, false);
+		const int32 Node = DependencyGraph.FindNode(Asset);
+		if (Node == INDEX_NONE) continue;
 
-			for (const auto& Dep : Deps)
-			{
-				bool bIsAlreadyInSet = false;
-				UsedAssetsDeps.Add(Dep, &bIsAlreadyInSet);
-				if (!bIsAlreadyInSet)
-				{
-					Stack.Add(Dep);
-				}
-			}
-		}
+		Roots.Add(Node);
 	}
+
+	// dependencies in graph are always game packages, so all reached nodes are game nodes
+	DependencyGraph.FindReachableNodes(Roots, UsedNodes, FollowedDependencyTypes, bForceSerialTraversal, &UsedNodeParents);
 }
 
 void FProjectCleanerDataManager::FindExcludedAssets(TSet<FName>& UsedAssets)
@@ -824,7 +1369,7 @@ void FProjectCleanerDataManager::FindExcludedAssets(TSet<FName>& UsedAssets)
 	// excluded by user
 	for (const auto& Asset : UserExcludedAssets)
 	{
-		UsedAssets.Add(Asset.PackageName);
+		MarkAsUsed(UsedAssets, Asset.PackageName, EProjectCleanerUsedAssetRoot::Excluded);
 
 		if (!PrimaryAssets.Contains(Asset))
 		{
@@ -848,7 +1393,7 @@ void FProjectCleanerDataManager::FindExcludedAssets(TSet<FName>& UsedAssets)
 
 		for (const auto& Asset : AllExcludedAssets)
 		{
-			UsedAssets.Add(Asset.PackageName);
+			MarkAsUsed(UsedAssets, Asset.PackageName, EProjectCleanerUsedAssetRoot::Excluded);
 			if (!PrimaryAssets.Contains(Asset))
 			{
 				ExcludedAssets.Add(Asset.PackageName);
@@ -861,7 +1406,7 @@ void FProjectCleanerDataManager::FindExcludedAssets(TSet<FName>& UsedAssets)
 	{
 		if (IsExcludedByClass(Asset))
 		{
-			UsedAssets.Add(Asset.PackageName);
+			MarkAsUsed(UsedAssets, Asset.PackageName, EProjectCleanerUsedAssetRoot::Excluded);
 			if (!PrimaryAssets.Contains(Asset))
 			{
 				ExcludedAssets.Add(Asset.PackageName);
@@ -870,109 +1415,511 @@ void FProjectCleanerDataManager::FindExcludedAssets(TSet<FName>& UsedAssets)
 	}
 }
 
-void FProjectCleanerDataManager::FillBucketWithAssets(TArray<FAssetData>& Bucket, const int32 BucketSize)
+void FProjectCleanerDataManager::MarkAsUsed(TSet<FName>& UsedAssets, const FName& PackageName, const EProjectCleanerUsedAssetRoot Root)
 {
-	// Searching Root assets
-	int32 Index = 0;
-	TArray<FName> Refs;
-	while (Bucket.Num() < BucketSize && UnusedAssets.IsValidIndex(Index))
+	UsedAssets.Add(PackageName);
+
+	// asset can be root for multiple reasons, first one is kept
+	const int32 Node = DependencyGraph.FindNode(PackageName);
+	if (Node != INDEX_NONE && UsedNodeRoots[Node] == EProjectCleanerUsedAssetRoot::None)
+	{
+		UsedNodeRoots[Node] = Root;
+	}
+}
+
+bool FProjectCleanerDataManager::PrepareBucketForDeletion(const TArray<FAssetData>& Bucket, TArray<UObject*>& LoadedAssets)
+{
+	TArray<FString> ObjectPaths;
+	ObjectPaths.Reserve(Bucket.Num());
+	
+	for (const auto& Asset : Bucket)
+	{
+		ObjectPaths.Add(Asset.ObjectPath.ToString());
+	}
+	
+	return AssetViewUtils::LoadAssetsIfNeeded(ObjectPaths, LoadedAssets, false, true);
+}
+
+int32 FProjectCleanerDataManager::DeleteBucket(const TArray<UObject*>& LoadedAssets)
+{
+	int32 DeletedAssetsNum = ObjectTools::DeleteObjects(LoadedAssets, false);
+	
+	if (DeletedAssetsNum == 0)
+	{
+		// bucket validated against graph, so only in memory references (open editors, transient objects etc.) get here
+		UE_LOG(LogProjectCleaner, Warning, TEXT("Failed to delete bucket of %d assets, referenced in memory. Force deleting."), LoadedAssets.Num());
+		DeletedAssetsNum = ObjectTools::ForceDeleteObjects(LoadedAssets, false);
+	}
+	
+	return DeletedAssetsNum;
+}
+
+void FProjectCleanerDataManager::ValidateBucket(TArray<FAssetData>& Bucket, const TSet<FName>& PendingPackages, const TSet<FName>& DeletedPackages, TArray<FAssetData>& OutHeldAssets, TMap<FName, FName>& OutBlockedPackages) const
+{
+	OutHeldAssets.Reset();
+	
+	TSet<FName> BucketPackages;
+	BucketPackages.Reserve(Bucket.Num());
+	for (const auto& Asset : Bucket)
+	{
+		BucketPackages.Add(Asset.PackageName);
+	}
+
+	// asset deleted by fast path only if all its referencers deleted together with it or before it.
+	// referenced by asset that still waiting for deletion - deferred, referenced by anything that stays in project - blocked
+	TMap<FName, FName> HeldPackages;
+	TSet<FName> BlockedInBucket;
+	for (const auto& Asset : Bucket)
 	{
-		const FAssetData CurrentAsset = UnusedAssets[Index];
-		AssetRegistry->Get().GetReferencers(CurrentAsset.PackageName, Refs);
-		Refs.RemoveAllSwap([&] (const FName& Ref)
+		const int32 Node = DependencyGraph.FindNode(Asset.PackageName);
+		if (Node == INDEX_NONE) continue;
+
+		// only package dependencies keep asset alive, management and searchable name edges does not block deletion
+		const auto Refs = DependencyGraph.GetReferencers(Node);
+		const auto RefTypes = DependencyGraph.GetReferencerTypes(Node);
+		for (int32 Edge = 0; Edge < Refs.Num(); ++Edge)
 		{
-			return !Ref.ToString().StartsWith(RelativeRoot.ToString()) || Ref.IsEqual(CurrentAsset.PackageName);
-		}, false);
-		Refs.Shrink();
+			if (!EnumHasAnyFlags(RefTypes[Edge], EProjectCleanerDependencyType::Package) || RemovedNodes[Refs[Edge]]) continue;
+
+			const FName& RefPackage = DependencyGraph.GetPackageName(Refs[Edge]);
+			if (BucketPackages.Contains(RefPackage) || DeletedPackages.Contains(RefPackage)) continue;
 
-		if (Refs.Num() == 0)
+			const bool bBlocked = !PendingPackages.Contains(RefPackage);
+			if (!HeldPackages.Contains(Asset.PackageName) || bBlocked)
+			{
+				HeldPackages.Add(Asset.PackageName, RefPackage);
+			}
+			if (bBlocked)
+			{
+				BlockedInBucket.Add(Asset.PackageName);
+				break;
+			}
+		}
+	}
+
+	// assets referenced by held assets of same bucket held too, otherwise fast path fails on them
+	bool bChanged = HeldPackages.Num() > 0;
+	while (bChanged)
+	{
+		bChanged = false;
+		for (const auto& Asset : Bucket)
 		{
-			Bucket.AddUnique(CurrentAsset);
-			UnusedAssets.RemoveAt(Index);
+			if (BlockedInBucket.Contains(Asset.PackageName)) continue;
+
+			const int32 Node = DependencyGraph.FindNode(Asset.PackageName);
+			if (Node == INDEX_NONE) continue;
+			
+			const auto Refs = DependencyGraph.GetReferencers(Node);
+			const auto RefTypes = DependencyGraph.GetReferencerTypes(Node);
+			for (int32 Edge = 0; Edge < Refs.Num(); ++Edge)
+			{
+				if (!EnumHasAnyFlags(RefTypes[Edge], EProjectCleanerDependencyType::Package)) continue;
+
+				const FName& RefPackage = DependencyGraph.GetPackageName(Refs[Edge]);
+				if (RefPackage == Asset.PackageName || !HeldPackages.Contains(RefPackage)) continue;
+
+				const bool bBlocked = BlockedInBucket.Contains(RefPackage);
+				if (HeldPackages.Contains(Asset.PackageName) && !bBlocked) continue;
+				
+				HeldPackages.Add(Asset.PackageName, RefPackage);
+				if (bBlocked)
+				{
+					BlockedInBucket.Add(Asset.PackageName);
+				}
+				bChanged = true;
+				break;
+			}
 		}
+	}
 
-		Refs.Reset();
+	if (HeldPackages.Num() == 0) return;
+
+	for (const auto& Asset : Bucket)
+	{
+		if (!HeldPackages.Contains(Asset.PackageName)) continue;
 		
-		++Index;
+		OutHeldAssets.Add(Asset);
+		if (BlockedInBucket.Contains(Asset.PackageName))
+		{
+			OutBlockedPackages.Add(Asset.PackageName, HeldPackages[Asset.PackageName]);
+		}
 	}
+
+	Bucket.RemoveAll([&](const FAssetData& Asset)
+	{
+		return HeldPackages.Contains(Asset.PackageName);
+	});
+}
+
+int32 FProjectCleanerDataManager::DeleteHeldAssets(const TArray<FAssetData>& DeferredAssets, TArray<FAssetData>& BlockedAssets, TMap<FName, FName>& BlockedPackages, TSet<FName>& PendingPackages, TSet<FName>& DeletedPackages, int32 BucketSize, FProjectCleanerDeletionJournal& DeletionJournal, FScopedSlowTask& DeleteSlowTask, bool& bOutAborted)
+{
+	int32 DeletedAssetsNum = 0;
+	int32 BucketIndex = 0;
+	const int32 Total = DeferredAssets.Num() + BlockedAssets.Num();
+	TArray<UObject*> LoadedAssets;
+
+	// held assets deleted in buckets too, sized same way as planned ones
+	const auto DeleteHeldBucket = [&](const TArray<FAssetData>& Bucket, const bool bForceDelete)
+	{
+		const double BucketStartTime = FPlatformTime::Seconds();
+		const int64 MemoryBeforeBucket = FPlatformMemory::GetStats().UsedPhysical;
 		
-	if (Bucket.Num() > 0)
+		if (!PrepareBucketForDeletion(Bucket, LoadedAssets))
+		{
+			UE_LOG(LogProjectCleaner, Error, TEXT("Failed to load some assets. Aborting."))
+			bOutAborted = true;
+			return false;
+		}
+
+		const int64 PeakMemory = FMath::Max<int64>(MemoryBeforeBucket, FPlatformMemory::GetStats().UsedPhysical);
+		const int32 BucketDeleted = bForceDelete ? ObjectTools::ForceDeleteObjects(LoadedAssets, false) : DeleteBucket(LoadedAssets);
+		DeletedAssetsNum += BucketDeleted;
+		LoadedAssets.Reset();
+
+		for (const auto& Asset : Bucket)
+		{
+			PendingPackages.Remove(Asset.PackageName);
+			if (!FPackageName::DoesPackageExist(Asset.PackageName.ToString()))
+			{
+				DeletedPackages.Add(Asset.PackageName);
+			}
+		}
+
+		int64 UsedMemory = FPlatformMemory::GetStats().UsedPhysical;
+		if (UsedMemory > DeletionMemoryLimit * 3 / 4)
+		{
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+			UsedMemory = FPlatformMemory::GetStats().UsedPhysical;
+		}
+		
+		const double BucketTime = FPlatformTime::Seconds() - BucketStartTime;
+		UE_LOG(
+			LogProjectCleaner,
+			Display,
+			TEXT("Held bucket %d: deleted %d of %d assets in %.2f s (%.1f assets/s), memory used %lld MB"),
+			++BucketIndex,
+			BucketDeleted,
+			Bucket.Num(),
+			BucketTime,
+			BucketTime > 0.0 ? BucketDeleted / BucketTime : 0.0,
+			UsedMemory / (1024 * 1024)
+		);
+
+		BucketSize = GetNextBucketSize(BucketSize, Bucket.Num(), PeakMemory - MemoryBeforeBucket, BucketTime, UsedMemory);
+		DeletionJournal.CommitHeldAssets(Bucket);
+		
+		DeleteSlowTask.EnterProgressFrame(0, ProjectCleanerUtility::GetDeletionProgressText(DeletedAssetsNum, Total, false));
+		return true;
+	};
+	
+	// all buckets processed, so deferred assets either can be deleted now or blocked by something that stays in project.
+	// they are in deletion order, so referencers come before referenced assets and bucket checked only against following ones
+	TArray<FAssetData> Bucket;
+	TArray<FAssetData> HeldAssets;
+	int32 Index = 0;
+	while (Index < DeferredAssets.Num())
+	{
+		if (DeleteSlowTask.ShouldCancel())
+		{
+			bCancelledByUser = true;
+			return DeletedAssetsNum;
+		}
+
+		// assets held again (cycle split between buckets) moved to next bucket, last bucket has all remaining assets so nothing held there
+		Bucket = MoveTemp(HeldAssets);
+		const int32 BucketEnd = FMath::Min(Index + BucketSize, DeferredAssets.Num());
+		for (; Index < BucketEnd; ++Index)
+		{
+			Bucket.Add(DeferredAssets[Index]);
+		}
+
+		ValidateBucket(Bucket, PendingPackages, DeletedPackages, HeldAssets, BlockedPackages);
+		HeldAssets.RemoveAll([&](const FAssetData& Asset)
+		{
+			if (!BlockedPackages.Contains(Asset.PackageName)) return false;
+			
+			PendingPackages.Remove(Asset.PackageName);
+			BlockedAssets.Add(Asset);
+			return true;
+		});
+
+		if (Bucket.Num() > 0 && !DeleteHeldBucket(Bucket, false)) return DeletedAssetsNum;
+	}
+
+	if (BlockedAssets.Num() == 0) return DeletedAssetsNum;
+	
+	// remaining assets referenced by packages that stay in project (through references that are not followed by analysis),
+	// they can be deleted only by force delete, which replaces references, so reporting every one of them
+	for (const auto& Asset : BlockedAssets)
 	{
-		return;
+		const FName* Referencer = BlockedPackages.Find(Asset.PackageName);
+		UE_LOG(LogProjectCleaner, Warning, TEXT("%s referenced by %s, force deleting"), *Asset.ObjectPath.ToString(), Referencer ? *Referencer->ToString() : TEXT("unknown"));
 	}
+	UE_LOG(LogProjectCleaner, Warning, TEXT("%d assets can't be deleted without force delete"), BlockedAssets.Num());
 
-	// if root assets not found, we deleting assets single by finding its referencers
-	if (UnusedAssets.Num() == 0)
+	Index = 0;
+	while (Index < BlockedAssets.Num())
 	{
-		return;
+		if (DeleteSlowTask.ShouldCancel())
+		{
+			bCancelledByUser = true;
+			return DeletedAssetsNum;
+		}
+		
+		const int32 BucketNum = FMath::Min(BucketSize, BlockedAssets.Num() - Index);
+		Bucket.Reset(BucketNum);
+		Bucket.Append(BlockedAssets.GetData() + Index, BucketNum);
+		Index += BucketNum;
+
+		if (!DeleteHeldBucket(Bucket, true)) return DeletedAssetsNum;
 	}
+
+	return DeletedAssetsNum;
+}
+
+int32 FProjectCleanerDataManager::GetNextBucketSize(const int32 BucketSize, const int32 BucketNum, const int64 BucketMemory, const double BucketTime, const int64 UsedMemory) const
+{
+	constexpr int32 MinBucketSize = 10;
+	constexpr int32 MaxBucketSize = 5000;
+	// long buckets make progress bar and cancel button unresponsive
+	constexpr double TargetBucketTime = 30.0;
+
+	if (BucketNum == 0) return BucketSize;
+
+	// bucket can use half of memory that left until limit
+	const int64 MemoryPerAsset = FMath::Max<int64>(BucketMemory / BucketNum, 1);
+	const int64 FreeMemory = FMath::Max<int64>(DeletionMemoryLimit - UsedMemory, 0);
+	const int64 SizeByMemory = FreeMemory / 2 / MemoryPerAsset;
 	
-	TArray<FAssetData> Stack;
-	Stack.Add(UnusedAssets[0]);
+	const double TimePerAsset = FMath::Max(BucketTime / BucketNum, 0.0001);
+	const int64 SizeByTime = static_cast<int64>(TargetBucketTime / TimePerAsset);
+
+	// growing gradually, measurements of single bucket can be noisy
+	const int64 NextSize = FMath::Min3<int64>(SizeByMemory, SizeByTime, static_cast<int64>(BucketSize) * 2);
 	
-	while (Stack.Num() > 0)
+	return FMath::Clamp<int32>(static_cast<int32>(NextSize), MinBucketSize, MaxBucketSize);
+}
+
+void FProjectCleanerDataManager::FindAssetsToDeleteWithoutLoading(TArray<FAssetData>& Bucket, TArray<FAssetData>& OutAssets) const
+{
+	OutAssets.Reset();
+
+	// asset must be loaded for deletion if its package or any referencer package is in memory,
+	// or if it referenced by other asset of bucket that will be loaded (loading referencer loads asset too)
+	TSet<FName> LoadedPackages;
+	for (const auto& Asset : Bucket)
 	{
-		const FAssetData Current = Stack.Pop(false);
-		Bucket.AddUnique(Current);
-		UnusedAssets.Remove(Current);
+		const int32 Node = DependencyGraph.FindNode(Asset.PackageName);
+		bool bLoaded = FindObjectFast<UPackage>(nullptr, Asset.PackageName) != nullptr;
 		
-		AssetRegistry->Get().GetReferencers(Current.PackageName, Refs);
+		if (!bLoaded && Node != INDEX_NONE)
+		{
+			for (const int32 Ref : DependencyGraph.GetReferencers(Node))
+			{
+				// package deleted by previous deletion, nothing to load
+				if (RemovedNodes[Ref]) continue;
+				
+				if (FindObjectFast<UPackage>(nullptr, DependencyGraph.GetPackageName(Ref)))
+				{
+					bLoaded = true;
+					break;
+				}
+			}
+		}
 		
-		Refs.RemoveAllSwap([&] (const FName& Ref)
+		if (bLoaded)
 		{
-			return !Ref.ToString().StartsWith(RelativeRoot.ToString()) || Ref.IsEqual(Current.PackageName);
-		}, false);
-		Refs.Shrink();
+			LoadedPackages.Add(Asset.PackageName);
+		}
+	}
 	
-		for (const auto& Ref : Refs)
+	// bucket ordered referencers first, but members of same cycle can go in any order, so repeating until nothing changes
+	bool bChanged = LoadedPackages.Num() > 0;
+	while (bChanged)
+	{
+		bChanged = false;
+		for (const auto& Asset : Bucket)
 		{
-			const FString ObjectPath = Ref.ToString() + TEXT(".") + FPaths::GetBaseFilename(*Ref.ToString());
-			const FAssetData AssetData = AssetRegistry->Get().GetAssetByObjectPath(FName{*ObjectPath});
-			if (AssetData.IsValid())
+			if (LoadedPackages.Contains(Asset.PackageName)) continue;
+
+			const int32 Node = DependencyGraph.FindNode(Asset.PackageName);
+			if (Node == INDEX_NONE) continue;
+			
+			for (const int32 Ref : DependencyGraph.GetReferencers(Node))
 			{
-				if (!Bucket.Contains(AssetData))
+				if (LoadedPackages.Contains(DependencyGraph.GetPackageName(Ref)))
 				{
-					Stack.Add(AssetData);
+					LoadedPackages.Add(Asset.PackageName);
+					bChanged = true;
+					break;
 				}
-
-				Bucket.AddUnique(AssetData);
-				UnusedAssets.Remove(AssetData);
 			}
 		}
-		
-		Refs.Reset();
 	}
+
+	for (const auto& Asset : Bucket)
+	{
+		if (!LoadedPackages.Contains(Asset.PackageName))
+		{
+			OutAssets.Add(Asset);
+		}
+	}
+	
+	Bucket.RemoveAll([&](const FAssetData& Asset)
+	{
+		return !LoadedPackages.Contains(Asset.PackageName);
+	});
 }
 
-bool FProjectCleanerDataManager::PrepareBucketForDeletion(const TArray<FAssetData>& Bucket, TArray<UObject*>& LoadedAssets)
+int32 FProjectCleanerDataManager::DeletePackageFiles(const TArray<FAssetData>& Assets) const
 {
-	TArray<FString> ObjectPaths;
-	ObjectPaths.Reserve(Bucket.Num());
+	if (Assets.Num() == 0) return 0;
 	
-	for (const auto& Asset : Bucket)
+	TArray<FString> Files;
+	GetPackageFiles(Assets, Files);
+
+	if (ISourceControlModule::Get().IsEnabled())
 	{
-		ObjectPaths.Add(Asset.ObjectPath.ToString());
+		// files that are not under source control deleted from disk
+		USourceControlHelpers::MarkFilesForDelete(Files, true);
 	}
+	else
+	{
+		for (const auto& File : Files)
+		{
+			IFileManager::Get().Delete(*File, false, true, true);
+		}
+	}
+
+	// asset registry removes assets of deleted files
+	AssetRegistry->Get().ScanModifiedAssetFiles(Files);
+
+	return GetNumRemovedAssets(Assets);
+}
+
+void FProjectCleanerDataManager::GetPackageFiles(const TArray<FAssetData>& Assets, TArray<FString>& OutFiles) const
+{
+	TSet<FName> Packages;
+	OutFiles.Reset(Assets.Num());
+	Packages.Reserve(Assets.Num());
 	
-	return AssetViewUtils::LoadAssetsIfNeeded(ObjectPaths, LoadedAssets, false, true);
+	for (const auto& Asset : Assets)
+	{
+		if (Packages.Contains(Asset.PackageName)) continue;
+		Packages.Add(Asset.PackageName);
+		
+		FString PackageFile;
+		if (FPackageName::DoesPackageExist(Asset.PackageName.ToString(), nullptr, &PackageFile))
+		{
+			OutFiles.Add(FPaths::ConvertRelativePathToFull(PackageFile));
+		}
+	}
 }
 
-int32 FProjectCleanerDataManager::DeleteBucket(const TArray<UObject*>& LoadedAssets)
+int32 FProjectCleanerDataManager::GetNumRemovedAssets(const TArray<FAssetData>& Assets) const
 {
-	int32 DeletedAssetsNum = ObjectTools::DeleteObjects(LoadedAssets, false);
+	int32 RemovedAssetsNum = 0;
+	for (const auto& Asset : Assets)
+	{
+		if (!FPackageName::DoesPackageExist(Asset.PackageName.ToString()))
+		{
+			++RemovedAssetsNum;
+		}
+	}
 	
-	if (DeletedAssetsNum == 0)
+	return RemovedAssetsNum;
+}
+
+void FProjectCleanerDataManager::RemoveDeletedAssets(const TArray<FAssetData>& Assets)
+{
+	// asset deleted if its package file is gone
+	TSet<FName> DeletedPackages;
+	TSet<FString> DeletedFiles;
+	for (const auto& Asset : Assets)
 	{
-		DeletedAssetsNum = ObjectTools::ForceDeleteObjects(LoadedAssets, false);
+		if (DeletedPackages.Contains(Asset.PackageName)) continue;
+		
+		const FString PackageName = Asset.PackageName.ToString();
+		if (FPackageName::DoesPackageExist(PackageName)) continue;
+		
+		DeletedPackages.Add(Asset.PackageName);
+		const int32 Node = DependencyGraph.FindNode(Asset.PackageName);
+		if (Node != INDEX_NONE)
+		{
+			RemovedNodes[Node] = true;
+		}
+		DeletedFiles.Add(FPaths::ConvertRelativePathToFull(FPackageName::LongPackageNameToFilename(PackageName, FPackageName::GetAssetPackageExtension())));
+		DeletedFiles.Add(FPaths::ConvertRelativePathToFull(FPackageName::LongPackageNameToFilename(PackageName, FPackageName::GetMapPackageExtension())));
+	}
+
+	if (DeletedPackages.Num() == 0) return;
+
+	const auto IsDeleted = [&](const FAssetData& Asset)
+	{
+		return DeletedPackages.Contains(Asset.PackageName);
+	};
+
+	// remaining assets shift, so every index into AllAssets remapped
+	TArray<int32> NewIndices;
+	NewIndices.Init(INDEX_NONE, AllAssets.Num());
+	int32 NumAssets = 0;
+	for (int32 Index = 0; Index < AllAssets.Num(); ++Index)
+	{
+		if (IsDeleted(AllAssets[Index])) continue;
+
+		NewIndices[Index] = NumAssets;
+		if (NumAssets != Index)
+		{
+			AllAssets[NumAssets] = MoveTemp(AllAssets[Index]);
+			AssetNodes[NumAssets] = AssetNodes[Index];
+		}
+		++NumAssets;
+	}
+	AllAssets.SetNum(NumAssets);
+	AssetNodes.SetNum(NumAssets);
+
+	AssetIndexByPath.Reset();
+	for (int32 Index = 0; Index < AllAssets.Num(); ++Index)
+	{
+		AssetIndexByPath.Add(AllAssets[Index].ObjectPath, Index);
+		AssetIndexByPath.Add(AllAssets[Index].PackageName, Index);
 	}
+
+	TMap<int32, TArray<FIndirectAssetUsage>> IndirectUsages = MoveTemp(IndirectAssets.Usages);
+	IndirectAssets.Usages.Reset();
+	for (auto& Usage : IndirectUsages)
+	{
+		const int32 NewIndex = NewIndices[Usage.Key];
+		if (NewIndex == INDEX_NONE) continue;
+		
+		IndirectAssets.Usages.Add(NewIndex, MoveTemp(Usage.Value));
+	}
+
+	// deleted assets were unused, so used assets stay valid. Graph keeps nodes and edges of deleted packages,
+	// so they marked as removed, otherwise next deletion treats them as referencers that stay in project.
+	// retained sizes of unused roots not recalculated, deleted roots just dropped from list
+	UnusedAssets.RemoveAll(IsDeleted);
+	EditorOnlyUsedAssets.RemoveAll(IsDeleted);
+	LargestUnusedRoots.RemoveAll(IsDeleted);
 	
-	return DeletedAssetsNum;
+	for (const auto& DeletedPackage : DeletedPackages)
+	{
+		PackageDiskSizes.Remove(DeletedPackage);
+	}
+	AllAssetsSize = GetTotalSize(AllAssets);
+	UnusedAssetsSize = GetTotalSize(UnusedAssets);
+
+	// only folders that lost their last file can become empty
+	TArray<int32> EmptiedDirectories;
+	ContentSnapshot.RemoveFiles(DeletedFiles, EmptiedDirectories);
+	if (EmptiedDirectories.Num() > 0)
+	{
+		FindEmptyFolders(bScanDeveloperContents);
+	}
 }
 
 void FProjectCleanerDataManager::CleanupAfterDelete()
 {
-	AnalyzeProject();
-
 	if (!IsRunningCommandlet())
 	{
 		ProjectCleanerUtility::FocusOnGameFolder();
@@ -1001,6 +1948,48 @@ bool FProjectCleanerDataManager::IsExcludedByPath(const FAssetData& AssetData) c
 	return false;
 }
 
+int64 FProjectCleanerDataManager::GetTotalSize(const TArray<FAssetData>& Assets) const
+{
+	int64 Size = 0;
+	for (const auto& Asset : Assets)
+	{
+		const int64* PackageSize = PackageDiskSizes.Find(Asset.PackageName);
+		if (!PackageSize) continue;
+		Size += *PackageSize;
+	}
+
+	return Size;
+}
+
+const FAssetData* FProjectCleanerDataManager::FindAssetByPath(const FName& Path) const
+{
+	const int32 Index = FindAssetIndexByPath(Path);
+	return Index != INDEX_NONE ? &AllAssets[Index] : nullptr;
+}
+
+int32 FProjectCleanerDataManager::FindAssetIndexByPath(const FName& Path) const
+{
+	const int32* Index = AssetIndexByPath.Find(Path);
+	return Index ? *Index : INDEX_NONE;
+}
+
+int32 FProjectCleanerDataManager::FindAssetIndexByIndirectReference(const FString& Path) const
+{
+	int32 Len = Path.Len();
+	
+	// if path ends with "_C" , then its probably blueprint class, so we just ignoring those two chars
+	if (Len > 2 && Path[Len - 2] == TEXT('_') && Path[Len - 1] == TEXT('C'))
+	{
+		Len -= 2;
+	}
+
+	// FNAME_Find does not add new entries to name table, if name not exists, then there is no such asset either
+	const FName Name{Len, *Path, FNAME_Find};
+	if (Name.IsNone()) return INDEX_NONE;
+	
+	return FindAssetIndexByPath(Name);
+}
+
 bool FProjectCleanerDataManager::IsLoadingAssets() const
 {
 	if (!AssetRegistry) return true;
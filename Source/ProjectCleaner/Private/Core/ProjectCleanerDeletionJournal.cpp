@@ -0,0 +1,188 @@
+﻿// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+#include "Core/ProjectCleanerDeletionJournal.h"
+// Engine Headers
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace ProjectCleanerDeletionJournal
+{
+	// text format, one record per line:
+	// ProjectCleanerDeletionJournal <Version> <NumPlannedAssets>
+	// A <ObjectPath> - planned asset, in deletion order
+	// B <NumAssets> - committed bucket
+	// H <ObjectPath> - asset held back from its bucket
+	// C <ObjectPath> - processed held asset
+	static const TCHAR* Header = TEXT("ProjectCleanerDeletionJournal");
+	static constexpr int32 Version = 2;
+}
+
+FProjectCleanerDeletionJournal::~FProjectCleanerDeletionJournal()
+{
+	// not finished explicitly, so journal left on disk for resuming
+	if (Writer)
+	{
+		Writer->Close();
+	}
+}
+
+bool FProjectCleanerDeletionJournal::Begin(const TArray<FAssetData>& PlannedAssets)
+{
+	using namespace ProjectCleanerDeletionJournal;
+	
+	Writer.Reset(IFileManager::Get().CreateFileWriter(*GetJournalFilePath(), FILEWRITE_Silent));
+	if (!Writer) return false;
+
+	// whole plan written at once, single flush
+	FString Plan;
+	Plan.Reserve(PlannedAssets.Num() * 64);
+	Plan += FString::Printf(TEXT("%s %d %d"), Header, Version, PlannedAssets.Num());
+	Plan += LINE_TERMINATOR;
+	for (const auto& Asset : PlannedAssets)
+	{
+		Plan += TEXT("A ");
+		Plan += Asset.ObjectPath.ToString();
+		Plan += LINE_TERMINATOR;
+	}
+
+	const FTCHARToUTF8 Utf8Plan{*Plan};
+	Writer->Serialize(const_cast<ANSICHAR*>(Utf8Plan.Get()), Utf8Plan.Length());
+	Writer->Flush();
+
+	return !Writer->IsError();
+}
+
+void FProjectCleanerDeletionJournal::CommitBucket(const int32 NumAssets)
+{
+	WriteLine(FString::Printf(TEXT("B %d"), NumAssets));
+}
+
+void FProjectCleanerDeletionJournal::HoldAssets(const TArray<FAssetData>& Assets)
+{
+	WriteAssets(TEXT("H "), Assets);
+}
+
+void FProjectCleanerDeletionJournal::CommitHeldAssets(const TArray<FAssetData>& Assets)
+{
+	WriteAssets(TEXT("C "), Assets);
+}
+
+void FProjectCleanerDeletionJournal::Finish()
+{
+	if (Writer)
+	{
+		Writer->Close();
+		Writer.Reset();
+	}
+	
+	Discard();
+}
+
+bool FProjectCleanerDeletionJournal::LoadRemainingAssets(TArray<FName>& OutRemainingAssets)
+{
+	using namespace ProjectCleanerDeletionJournal;
+	
+	OutRemainingAssets.Reset();
+
+	TArray<FString> Lines;
+	if (!FFileHelper::LoadFileToStringArray(Lines, *GetJournalFilePath())) return false;
+	if (Lines.Num() == 0) return false;
+
+	TArray<FString> HeaderParts;
+	Lines[0].ParseIntoArrayWS(HeaderParts);
+	if (HeaderParts.Num() != 3 || HeaderParts[0] != Header || FCString::Atoi(*HeaderParts[1]) != Version) return false;
+	
+	const int32 NumPlannedAssets = FCString::Atoi(*HeaderParts[2]);
+	TArray<FName> PlannedAssets;
+	PlannedAssets.Reserve(NumPlannedAssets);
+	int32 NumCommittedAssets = 0;
+	// held assets deleted in different order than held, so tracked by path instead of count
+	TArray<FName> HeldAssets;
+	TSet<FName> CommittedHeldAssets;
+
+	for (int32 Index = 1; Index < Lines.Num(); ++Index)
+	{
+		const FString& Line = Lines[Index];
+		if (Line.StartsWith(TEXT("A ")))
+		{
+			PlannedAssets.Add(FName{*Line.RightChop(2)});
+		}
+		else if (Line.StartsWith(TEXT("B ")))
+		{
+			NumCommittedAssets += FCString::Atoi(*Line.RightChop(2));
+		}
+		else if (Line.StartsWith(TEXT("H ")))
+		{
+			HeldAssets.Add(FName{*Line.RightChop(2)});
+		}
+		else if (Line.StartsWith(TEXT("C ")))
+		{
+			CommittedHeldAssets.Add(FName{*Line.RightChop(2)});
+		}
+	}
+
+	// crashed while writing plan, nothing deleted yet
+	if (PlannedAssets.Num() != NumPlannedAssets) return false;
+
+	// crash between holding assets and committing their bucket leaves them in both lists
+	TSet<FName> RemainingAssets;
+	for (int32 Index = NumCommittedAssets; Index < PlannedAssets.Num(); ++Index)
+	{
+		RemainingAssets.Add(PlannedAssets[Index]);
+		OutRemainingAssets.Add(PlannedAssets[Index]);
+	}
+
+	for (const auto& Asset : HeldAssets)
+	{
+		if (CommittedHeldAssets.Contains(Asset) || RemainingAssets.Contains(Asset)) continue;
+
+		RemainingAssets.Add(Asset);
+		OutRemainingAssets.Add(Asset);
+	}
+
+	return true;
+}
+
+bool FProjectCleanerDeletionJournal::Exists()
+{
+	return IFileManager::Get().FileExists(*GetJournalFilePath());
+}
+
+void FProjectCleanerDeletionJournal::Discard()
+{
+	IFileManager::Get().Delete(*GetJournalFilePath(), false, true, true);
+}
+
+FString FProjectCleanerDeletionJournal::GetJournalFilePath()
+{
+	return FPaths::ProjectSavedDir() / TEXT("ProjectCleaner") / TEXT("DeletionJournal.txt");
+}
+
+void FProjectCleanerDeletionJournal::WriteLine(const FString& Line)
+{
+	if (!Writer) return;
+
+	const FTCHARToUTF8 Utf8Line{*(Line + LINE_TERMINATOR)};
+	Writer->Serialize(const_cast<ANSICHAR*>(Utf8Line.Get()), Utf8Line.Length());
+	Writer->Flush();
+}
+
+void FProjectCleanerDeletionJournal::WriteAssets(const TCHAR* Prefix, const TArray<FAssetData>& Assets)
+{
+	if (!Writer || Assets.Num() == 0) return;
+
+	// all records written at once, single flush
+	FString Records;
+	Records.Reserve(Assets.Num() * 64);
+	for (const auto& Asset : Assets)
+	{
+		Records += Prefix;
+		Records += Asset.ObjectPath.ToString();
+		Records += LINE_TERMINATOR;
+	}
+
+	const FTCHARToUTF8 Utf8Records{*Records};
+	Writer->Serialize(const_cast<ANSICHAR*>(Utf8Records.Get()), Utf8Records.Length());
+	Writer->Flush();
+}
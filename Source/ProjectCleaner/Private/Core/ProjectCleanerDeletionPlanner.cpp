@@ -0,0 +1,112 @@
+﻿// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+#include "Core/ProjectCleanerDeletionPlanner.h"
+
+void FProjectCleanerDeletionPlanner::Build(const FProjectCleanerDependencyGraph& Graph, const TArray<FAssetData>& Assets)
+{
+	Reset();
+
+	const int32 NumNodes = Graph.GetNumNodes();
+	OrderedAssets.Reserve(Assets.Num());
+	
+	TBitArray<> PendingNodes{false, NumNodes};
+	TArray<int32> AssetNodes;
+	AssetNodes.Reserve(Assets.Num());
+	
+	for (const auto& Asset : Assets)
+	{
+		const int32 Node = Graph.FindNode(Asset.PackageName);
+		AssetNodes.Add(Node);
+		
+		if (Node != INDEX_NONE)
+		{
+			PendingNodes[Node] = true;
+			continue;
+		}
+		
+		// assets without node have no game referencers, each is separate component
+		OrderedAssets.Add(Asset);
+		ComponentEnds.Add(OrderedAssets.Num());
+	}
+
+	// assets of every node, same layout as graph edges
+	TArray<int32> NodeAssetOffsets;
+	TArray<int32> NodeAssets;
+	NodeAssetOffsets.Init(0, NumNodes + 1);
+	for (const int32 Node : AssetNodes)
+	{
+		if (Node != INDEX_NONE)
+		{
+			++NodeAssetOffsets[Node + 1];
+		}
+	}
+	for (int32 Node = 0; Node < NumNodes; ++Node)
+	{
+		NodeAssetOffsets[Node + 1] += NodeAssetOffsets[Node];
+	}
+	
+	NodeAssets.SetNumUninitialized(NodeAssetOffsets[NumNodes]);
+	TArray<int32> NodeAssetCursors{NodeAssetOffsets};
+	for (int32 Index = 0; Index < AssetNodes.Num(); ++Index)
+	{
+		const int32 Node = AssetNodes[Index];
+		if (Node != INDEX_NONE)
+		{
+			NodeAssets[NodeAssetCursors[Node]++] = Index;
+		}
+	}
+
+	TArray<int32> ComponentNodes;
+	TArray<int32> ComponentOffsets;
+	Graph.FindStronglyConnectedComponents(PendingNodes, ComponentNodes, ComponentOffsets);
+	
+	for (int32 Component = 0; Component < ComponentOffsets.Num() - 1; ++Component)
+	{
+		for (int32 Member = ComponentOffsets[Component]; Member < ComponentOffsets[Component + 1]; ++Member)
+		{
+			const int32 Node = ComponentNodes[Member];
+			for (int32 Asset = NodeAssetOffsets[Node]; Asset < NodeAssetOffsets[Node + 1]; ++Asset)
+			{
+				OrderedAssets.Add(Assets[NodeAssets[Asset]]);
+			}
+		}
+		
+		ComponentEnds.Add(OrderedAssets.Num());
+	}
+}
+
+void FProjectCleanerDeletionPlanner::Reset()
+{
+	OrderedAssets.Reset();
+	ComponentEnds.Reset();
+	NextComponent = 0;
+}
+
+bool FProjectCleanerDeletionPlanner::GetNextBucket(const int32 MaxAssets, TArray<FAssetData>& OutBucket)
+{
+	OutBucket.Reset();
+	
+	if (IsFinished()) return false;
+
+	const int32 Begin = NextComponent > 0 ? ComponentEnds[NextComponent - 1] : 0;
+	int32 End = ComponentEnds[NextComponent++];
+	
+	while (NextComponent < ComponentEnds.Num() && ComponentEnds[NextComponent] - Begin <= MaxAssets)
+	{
+		End = ComponentEnds[NextComponent++];
+	}
+
+	OutBucket.Append(OrderedAssets.GetData() + Begin, End - Begin);
+	
+	return true;
+}
+
+const TArray<FAssetData>& FProjectCleanerDeletionPlanner::GetOrderedAssets() const
+{
+	return OrderedAssets;
+}
+
+bool FProjectCleanerDeletionPlanner::IsFinished() const
+{
+	return NextComponent >= ComponentEnds.Num();
+}
@@ -0,0 +1,514 @@
+﻿// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+#include "Core/ProjectCleanerDependencyGraph.h"
+// Engine Headers
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Async/ParallelFor.h"
+#include "Engine/AssetManager.h"
+
+namespace ProjectCleanerDependencyGraph
+{
+	// smaller frontiers expanded on calling thread, task overhead is bigger than work
+	static constexpr int32 MinNodesPerWorker = 1024;
+
+	static EProjectCleanerDependencyType GetDependencyType(const FAssetDependency& Dependency)
+	{
+		using namespace UE::AssetRegistry;
+		
+		switch (Dependency.Category)
+		{
+			case EDependencyCategory::Package:
+			{
+				const bool bHard = EnumHasAnyFlags(Dependency.Properties, EDependencyProperty::Hard);
+				const bool bGame = EnumHasAnyFlags(Dependency.Properties, EDependencyProperty::Game);
+				if (bGame)
+				{
+					return bHard ? EProjectCleanerDependencyType::Hard : EProjectCleanerDependencyType::Soft;
+				}
+				return bHard ? EProjectCleanerDependencyType::EditorOnlyHard : EProjectCleanerDependencyType::EditorOnlySoft;
+			}
+			case EDependencyCategory::Manage:
+				return EProjectCleanerDependencyType::Management;
+			case EDependencyCategory::SearchableName:
+				return EProjectCleanerDependencyType::SearchableName;
+			default:
+				return EProjectCleanerDependencyType::None;
+		}
+	}
+
+	/**
+	 * @brief Atomically sets node bit
+	 * @return true if bit was not set before, so calling thread owns the node
+	 */
+	static bool ClaimNode(TArray<int32>& VisitedWords, const int32 Node)
+	{
+		// unsigned mask, shifting into sign bit of int32 is undefined
+		const uint32 Mask = 1u << (Node & 31);
+		volatile int32* Word = &VisitedWords[Node >> 5];
+		
+		// cheap check first, most nodes in dense graphs are already visited
+		if (static_cast<uint32>(*Word) & Mask) return false;
+
+		return (static_cast<uint32>(FPlatformAtomics::InterlockedOr(Word, static_cast<int32>(Mask))) & Mask) == 0;
+	}
+
+	static uint64 MakeEdgeKey(const int32 Source, const int32 Target)
+	{
+		return (static_cast<uint64>(Source) << 32) | static_cast<uint32>(Target);
+	}
+
+	/**
+	 * @brief Package of referencer. Management referencers are primary asset ids, not packages, so resolved through asset manager
+	 * @return None if referencer can't be resolved to package
+	 */
+	static FName GetReferencerPackage(const FAssetIdentifier& AssetId)
+	{
+		if (!AssetId.PackageName.IsNone()) return AssetId.PackageName;
+
+		const FPrimaryAssetId PrimaryAssetId = AssetId.GetPrimaryAssetId();
+		if (!PrimaryAssetId.IsValid() || !UAssetManager::IsValid()) return NAME_None;
+
+		const FSoftObjectPath PrimaryAssetPath = UAssetManager::Get().GetPrimaryAssetPath(PrimaryAssetId);
+		if (PrimaryAssetPath.IsNull()) return NAME_None;
+		
+		return FName{*PrimaryAssetPath.GetLongPackageName()};
+	}
+}
+
+void FProjectCleanerDependencyGraph::Build(const IAssetRegistry& AssetRegistry, const TArray<FName>& GamePackages)
+{
+	Reset();
+
+	MountPointIds.Add(FName{TEXT("Game")}, GameMountPoint);
+
+	PackageNames.Reserve(GamePackages.Num());
+	NodeByPackageName.Reserve(GamePackages.Num());
+	for (const auto& PackageName : GamePackages)
+	{
+		FindOrAddNode(PackageName);
+	}
+	NumGameNodes = PackageNames.Num();
+
+	// every edge ends in game node, so asking referencers of game packages is enough to get all edges we interested in
+	TArray<int32> EdgeSources;
+	TArray<int32> EdgeTargets;
+	TArray<EProjectCleanerDependencyType> EdgeTypes;
+	EdgeSources.Reserve(NumGameNodes * 4);
+	EdgeTargets.Reserve(NumGameNodes * 4);
+	EdgeTypes.Reserve(NumGameNodes * 4);
+
+	// same referencer can be returned for every category, those merged into single edge with multiple types
+	TMap<uint64, int32> EdgeByKey;
+	EdgeByKey.Reserve(NumGameNodes * 4);
+	const auto AddEdge = [&](const int32 Source, const int32 Target, const EProjectCleanerDependencyType Type)
+	{
+		const uint64 Key = MakeEdgeKey(Source, Target);
+		const int32* ExistingEdge = EdgeByKey.Find(Key);
+		if (ExistingEdge)
+		{
+			EdgeTypes[*ExistingEdge] |= Type;
+			return;
+		}
+
+		EdgeByKey.Add(Key, EdgeSources.Num());
+		EdgeSources.Add(Source);
+		EdgeTargets.Add(Target);
+		EdgeTypes.Add(Type);
+	};
+	
+	TArray<FAssetDependency> Refs;
+	for (int32 Node = 0; Node < NumGameNodes; ++Node)
+	{
+		Refs.Reset();
+		AssetRegistry.GetReferencers(FAssetIdentifier{PackageNames[Node]}, Refs, UE::AssetRegistry::EDependencyCategory::All);
+
+		for (const auto& Ref : Refs)
+		{
+			const EProjectCleanerDependencyType Type = GetDependencyType(Ref);
+			if (Type == EProjectCleanerDependencyType::None) continue;
+			
+			const FName RefPackage = GetReferencerPackage(Ref.AssetId);
+			if (RefPackage.IsNone() || RefPackage == PackageNames[Node]) continue;
+
+			AddEdge(FindOrAddNode(RefPackage), Node, Type);
+		}
+	}
+
+	// searchable names (data table rows, gameplay tags etc.) are separate identifiers, not packages, so package referencers query
+	// does not return them. Instead dependencies of every known package asked, searchable name edge goes to package owning the name
+	TArray<FAssetIdentifier> SearchableNames;
+	const int32 NumKnownNodes = PackageNames.Num();
+	for (int32 Node = 0; Node < NumKnownNodes; ++Node)
+	{
+		SearchableNames.Reset();
+		AssetRegistry.GetDependencies(FAssetIdentifier{PackageNames[Node]}, SearchableNames, UE::AssetRegistry::EDependencyCategory::SearchableName);
+
+		for (const auto& SearchableName : SearchableNames)
+		{
+			if (SearchableName.PackageName == PackageNames[Node]) continue;
+			
+			const int32* Target = NodeByPackageName.Find(SearchableName.PackageName);
+			if (!Target || *Target >= NumGameNodes) continue;
+
+			AddEdge(Node, *Target, EProjectCleanerDependencyType::SearchableName);
+		}
+	}
+
+	// counting sort of edges by source and by target
+	const int32 NumNodes = PackageNames.Num();
+	const int32 NumEdges = EdgeSources.Num();
+	DependencyOffsets.SetNumZeroed(NumNodes + 1);
+	ReferencerOffsets.SetNumZeroed(NumNodes + 1);
+
+	for (int32 Edge = 0; Edge < NumEdges; ++Edge)
+	{
+		++DependencyOffsets[EdgeSources[Edge] + 1];
+		++ReferencerOffsets[EdgeTargets[Edge] + 1];
+	}
+
+	for (int32 Node = 0; Node < NumNodes; ++Node)
+	{
+		DependencyOffsets[Node + 1] += DependencyOffsets[Node];
+		ReferencerOffsets[Node + 1] += ReferencerOffsets[Node];
+	}
+
+	Dependencies.SetNumUninitialized(NumEdges);
+	DependencyTypes.SetNumUninitialized(NumEdges);
+	Referencers.SetNumUninitialized(NumEdges);
+	ReferencerTypes.SetNumUninitialized(NumEdges);
+	
+	TArray<int32> DependencyCursors{DependencyOffsets.GetData(), NumNodes};
+	TArray<int32> ReferencerCursors{ReferencerOffsets.GetData(), NumNodes};
+	for (int32 Edge = 0; Edge < NumEdges; ++Edge)
+	{
+		const int32 DependencySlot = DependencyCursors[EdgeSources[Edge]]++;
+		Dependencies[DependencySlot] = EdgeTargets[Edge];
+		DependencyTypes[DependencySlot] = EdgeTypes[Edge];
+		
+		const int32 ReferencerSlot = ReferencerCursors[EdgeTargets[Edge]]++;
+		Referencers[ReferencerSlot] = EdgeSources[Edge];
+		ReferencerTypes[ReferencerSlot] = EdgeTypes[Edge];
+	}
+}
+
+void FProjectCleanerDependencyGraph::Reset()
+{
+	PackageNames.Reset();
+	NodeByPackageName.Reset();
+	NodeMountPoints.Reset();
+	MountPointIds.Reset();
+	NumGameNodes = 0;
+	DependencyOffsets.Reset();
+	Dependencies.Reset();
+	DependencyTypes.Reset();
+	ReferencerOffsets.Reset();
+	Referencers.Reset();
+	ReferencerTypes.Reset();
+}
+
+int32 FProjectCleanerDependencyGraph::GetNumNodes() const
+{
+	return PackageNames.Num();
+}
+
+int32 FProjectCleanerDependencyGraph::GetNumGameNodes() const
+{
+	return NumGameNodes;
+}
+
+int32 FProjectCleanerDependencyGraph::GetNumEdges() const
+{
+	return Dependencies.Num();
+}
+
+int32 FProjectCleanerDependencyGraph::GetNumEdges(const EProjectCleanerDependencyType EdgeTypes) const
+{
+	int32 NumEdges = 0;
+	for (const auto Type : DependencyTypes)
+	{
+		if (EnumHasAnyFlags(Type, EdgeTypes))
+		{
+			++NumEdges;
+		}
+	}
+
+	return NumEdges;
+}
+
+bool FProjectCleanerDependencyGraph::IsGameNode(const int32 Node) const
+{
+	return NodeMountPoints[Node] == GameMountPoint;
+}
+
+const FName& FProjectCleanerDependencyGraph::GetPackageName(const int32 Node) const
+{
+	return PackageNames[Node];
+}
+
+int32 FProjectCleanerDependencyGraph::FindNode(const FName& PackageName) const
+{
+	const int32* Node = NodeByPackageName.Find(PackageName);
+	return Node ? *Node : INDEX_NONE;
+}
+
+TArrayView<const int32> FProjectCleanerDependencyGraph::GetDependencies(const int32 Node) const
+{
+	return TArrayView<const int32>{Dependencies.GetData() + DependencyOffsets[Node], DependencyOffsets[Node + 1] - DependencyOffsets[Node]};
+}
+
+TArrayView<const EProjectCleanerDependencyType> FProjectCleanerDependencyGraph::GetDependencyTypes(const int32 Node) const
+{
+	return TArrayView<const EProjectCleanerDependencyType>{DependencyTypes.GetData() + DependencyOffsets[Node], DependencyOffsets[Node + 1] - DependencyOffsets[Node]};
+}
+
+TArrayView<const int32> FProjectCleanerDependencyGraph::GetReferencers(const int32 Node) const
+{
+	return TArrayView<const int32>{Referencers.GetData() + ReferencerOffsets[Node], ReferencerOffsets[Node + 1] - ReferencerOffsets[Node]};
+}
+
+TArrayView<const EProjectCleanerDependencyType> FProjectCleanerDependencyGraph::GetReferencerTypes(const int32 Node) const
+{
+	return TArrayView<const EProjectCleanerDependencyType>{ReferencerTypes.GetData() + ReferencerOffsets[Node], ReferencerOffsets[Node + 1] - ReferencerOffsets[Node]};
+}
+
+void FProjectCleanerDependencyGraph::FindReachableNodes(const TArray<int32>& Roots, TBitArray<>& OutReached, const EProjectCleanerDependencyType EdgeTypes, const bool bForceSerial, TArray<int32>* OutParents) const
+{
+	using namespace ProjectCleanerDependencyGraph;
+
+	const int32 NumNodes = GetNumNodes();
+	TArray<int32> VisitedWords;
+	VisitedWords.SetNumZeroed((NumNodes + 31) / 32);
+
+	// parent written only by thread that claimed node, so no synchronization needed
+	if (OutParents)
+	{
+		OutParents->Init(INDEX_NONE, NumNodes);
+	}
+	int32* Parents = OutParents ? OutParents->GetData() : nullptr;
+
+	TArray<int32> Frontier;
+	Frontier.Reserve(Roots.Num());
+	for (const int32 Root : Roots)
+	{
+		if (ClaimNode(VisitedWords, Root))
+		{
+			Frontier.Add(Root);
+		}
+	}
+
+	const int32 MaxWorkers = bForceSerial ? 1 : FMath::Max(1, FTaskGraphInterface::Get().GetNumWorkerThreads());
+	TArray<TArray<int32>> WorkerFrontiers;
+	TArray<int32> NextFrontier;
+	
+	while (Frontier.Num() > 0)
+	{
+		NextFrontier.Reset();
+		
+		const int32 NumWorkers = FMath::Clamp(Frontier.Num() / MinNodesPerWorker, 1, MaxWorkers);
+		if (NumWorkers == 1)
+		{
+			for (const int32 Node : Frontier)
+			{
+				for (int32 Edge = DependencyOffsets[Node]; Edge < DependencyOffsets[Node + 1]; ++Edge)
+				{
+					if (EnumHasAnyFlags(DependencyTypes[Edge], EdgeTypes) && ClaimNode(VisitedWords, Dependencies[Edge]))
+					{
+						NextFrontier.Add(Dependencies[Edge]);
+						if (Parents)
+						{
+							Parents[Dependencies[Edge]] = Node;
+						}
+					}
+				}
+			}
+		}
+		else
+		{
+			// every worker takes contiguous part of level and collects claimed nodes to its own array
+			WorkerFrontiers.SetNum(NumWorkers);
+			const int32 NodesPerWorker = FMath::DivideAndRoundUp(Frontier.Num(), NumWorkers);
+			
+			ParallelFor(NumWorkers, [&](const int32 WorkerIndex)
+			{
+				TArray<int32>& WorkerFrontier = WorkerFrontiers[WorkerIndex];
+				WorkerFrontier.Reset();
+
+				const int32 Begin = WorkerIndex * NodesPerWorker;
+				const int32 End = FMath::Min(Begin + NodesPerWorker, Frontier.Num());
+				for (int32 Index = Begin; Index < End; ++Index)
+				{
+					const int32 Node = Frontier[Index];
+					for (int32 Edge = DependencyOffsets[Node]; Edge < DependencyOffsets[Node + 1]; ++Edge)
+					{
+						if (EnumHasAnyFlags(DependencyTypes[Edge], EdgeTypes) && ClaimNode(VisitedWords, Dependencies[Edge]))
+						{
+							WorkerFrontier.Add(Dependencies[Edge]);
+							if (Parents)
+							{
+								Parents[Dependencies[Edge]] = Node;
+							}
+						}
+					}
+				}
+			});
+
+			for (const auto& WorkerFrontier : WorkerFrontiers)
+			{
+				NextFrontier.Append(WorkerFrontier);
+			}
+		}
+
+		Swap(Frontier, NextFrontier);
+	}
+
+	OutReached.Init(false, NumNodes);
+	for (int32 Node = 0; Node < NumNodes; ++Node)
+	{
+		if (static_cast<uint32>(VisitedWords[Node >> 5]) & (1u << (Node & 31)))
+		{
+			OutReached[Node] = true;
+		}
+	}
+}
+
+void FProjectCleanerDependencyGraph::FindNodesWithExternalReferencers(TBitArray<>& OutNodes, const EProjectCleanerDependencyType EdgeTypes) const
+{
+	const int32 NumNodes = GetNumNodes();
+	OutNodes.Init(false, NumNodes);
+
+	for (int32 Node = 0; Node < NumNodes; ++Node)
+	{
+		const int32 MountPoint = NodeMountPoints[Node];
+		for (int32 Edge = ReferencerOffsets[Node]; Edge < ReferencerOffsets[Node + 1]; ++Edge)
+		{
+			if (NodeMountPoints[Referencers[Edge]] != MountPoint && EnumHasAnyFlags(ReferencerTypes[Edge], EdgeTypes))
+			{
+				OutNodes[Node] = true;
+				break;
+			}
+		}
+	}
+}
+
+void FProjectCleanerDependencyGraph::FindStronglyConnectedComponents(const TBitArray<>& Nodes, TArray<int32>& OutComponentNodes, TArray<int32>& OutComponentOffsets) const
+{
+	const int32 NumNodes = GetNumNodes();
+	check(Nodes.Num() == NumNodes);
+	
+	OutComponentNodes.Reset();
+	OutComponentOffsets.Reset();
+	OutComponentOffsets.Add(0);
+
+	// iterative Tarjan over referencer edges, component emitted only after all components reachable from it,
+	// so referencers of component always emitted before it
+	struct FFrame
+	{
+		int32 Node;
+		int32 Edge;
+	};
+	
+	TArray<int32> NodeIndices;
+	TArray<int32> LowLinks;
+	NodeIndices.Init(INDEX_NONE, NumNodes);
+	LowLinks.Init(INDEX_NONE, NumNodes);
+	TBitArray<> OnStack{false, NumNodes};
+	TArray<int32> Stack;
+	TArray<FFrame> CallStack;
+	int32 NextIndex = 0;
+
+	const auto Visit = [&](const int32 Node)
+	{
+		NodeIndices[Node] = NextIndex;
+		LowLinks[Node] = NextIndex;
+		++NextIndex;
+		Stack.Add(Node);
+		OnStack[Node] = true;
+		CallStack.Add(FFrame{Node, ReferencerOffsets[Node]});
+	};
+
+	for (TConstSetBitIterator<> It(Nodes); It; ++It)
+	{
+		if (NodeIndices[It.GetIndex()] != INDEX_NONE) continue;
+
+		Visit(It.GetIndex());
+		while (CallStack.Num() > 0)
+		{
+			const int32 Node = CallStack.Last().Node;
+			int32& Edge = CallStack.Last().Edge;
+			
+			bool bDescended = false;
+			while (Edge < ReferencerOffsets[Node + 1])
+			{
+				const int32 Ref = Referencers[Edge++];
+				if (!Nodes[Ref]) continue;
+
+				if (NodeIndices[Ref] == INDEX_NONE)
+				{
+					Visit(Ref);
+					bDescended = true;
+					break;
+				}
+
+				if (OnStack[Ref])
+				{
+					LowLinks[Node] = FMath::Min(LowLinks[Node], NodeIndices[Ref]);
+				}
+			}
+			
+			if (bDescended) continue;
+
+			if (LowLinks[Node] == NodeIndices[Node])
+			{
+				int32 Member;
+				do
+				{
+					Member = Stack.Pop(false);
+					OnStack[Member] = false;
+					OutComponentNodes.Add(Member);
+				}
+				while (Member != Node);
+				
+				OutComponentOffsets.Add(OutComponentNodes.Num());
+			}
+
+			CallStack.Pop(false);
+			if (CallStack.Num() > 0)
+			{
+				const int32 Parent = CallStack.Last().Node;
+				LowLinks[Parent] = FMath::Min(LowLinks[Parent], LowLinks[Node]);
+			}
+		}
+	}
+}
+
+int32 FProjectCleanerDependencyGraph::FindOrAddNode(const FName& PackageName)
+{
+	const int32* Node = NodeByPackageName.Find(PackageName);
+	if (Node) return *Node;
+
+	const int32 NewNode = PackageNames.Add(PackageName);
+	NodeByPackageName.Add(PackageName, NewNode);
+
+	// mount point is first path segment, "/Engine/Materials/M_Base" => "Engine"
+	TCHAR NameBuffer[NAME_SIZE];
+	PackageName.GetPlainNameString(NameBuffer);
+	
+	const TCHAR* MountPointBegin = NameBuffer[0] == TEXT('/') ? NameBuffer + 1 : NameBuffer;
+	const TCHAR* MountPointEnd = FCString::Strchr(MountPointBegin, TEXT('/'));
+	const int32 MountPointLen = MountPointEnd ? static_cast<int32>(MountPointEnd - MountPointBegin) : FCString::Strlen(MountPointBegin);
+	const FName MountPointName{MountPointLen, MountPointBegin};
+
+	const int32* MountPoint = MountPointIds.Find(MountPointName);
+	if (MountPoint)
+	{
+		NodeMountPoints.Add(*MountPoint);
+	}
+	else
+	{
+		const int32 NewMountPoint = MountPointIds.Num();
+		MountPointIds.Add(MountPointName, NewMountPoint);
+		NodeMountPoints.Add(NewMountPoint);
+	}
+	
+	return NewNode;
+}
@@ -0,0 +1,107 @@
+﻿// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+#include "Core/ProjectCleanerDirectoryWalker.h"
+// Engine Headers
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformFilemanager.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "Misc/ScopeLock.h"
+
+namespace ProjectCleanerDirectoryWalker
+{
+	struct FPendingDirectory
+	{
+		FString Path;
+		int64 Id;
+	};
+
+	struct FWorkerQueue
+	{
+		FCriticalSection Lock;
+		TArray<FPendingDirectory> Directories;
+	};
+
+	bool PopDirectory(TArray<FWorkerQueue>& Queues, const int32 WorkerIndex, FPendingDirectory& OutDirectory)
+	{
+		// own queue used as stack, so worker goes deep into tree it already started
+		{
+			FWorkerQueue& OwnQueue = Queues[WorkerIndex];
+			FScopeLock ScopeLock(&OwnQueue.Lock);
+			if (OwnQueue.Directories.Num() > 0)
+			{
+				OutDirectory = OwnQueue.Directories.Pop(false);
+				return true;
+			}
+		}
+
+		// stealing oldest directory from other workers, they are closer to root and most likely contain bigger subtrees
+		for (int32 Offset = 1; Offset < Queues.Num(); ++Offset)
+		{
+			FWorkerQueue& Victim = Queues[(WorkerIndex + Offset) % Queues.Num()];
+			FScopeLock ScopeLock(&Victim.Lock);
+			if (Victim.Directories.Num() > 0)
+			{
+				OutDirectory = MoveTemp(Victim.Directories[0]);
+				Victim.Directories.RemoveAt(0, 1, false);
+				return true;
+			}
+		}
+
+		return false;
+	}
+}
+
+int32 FProjectCleanerDirectoryWalker::GetNumWorkers()
+{
+	// worker threads plus calling thread, which also participates in ParallelFor
+	return FMath::Max(1, FTaskGraphInterface::Get().GetNumWorkerThreads() + 1);
+}
+
+void FProjectCleanerDirectoryWalker::Walk(const FString& RootDir, const int64 RootId, const int32 NumWorkers, FVisitor Visitor)
+{
+	using namespace ProjectCleanerDirectoryWalker;
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	if (!PlatformFile.DirectoryExists(*RootDir)) return;
+
+	TArray<FWorkerQueue> Queues;
+	Queues.SetNum(FMath::Max(1, NumWorkers));
+	Queues[0].Directories.Add(FPendingDirectory{RootDir, RootId});
+
+	// number of directories that are queued or currently iterated, walk finished when it reaches zero
+	FThreadSafeCounter PendingDirectories{1};
+
+	ParallelFor(Queues.Num(), [&](const int32 WorkerIndex)
+	{
+		FPendingDirectory Directory;
+		while (true)
+		{
+			if (!PopDirectory(Queues, WorkerIndex, Directory))
+			{
+				if (PendingDirectories.GetValue() == 0) break;
+
+				// other workers still iterating, they may queue more directories
+				FPlatformProcess::Yield();
+				continue;
+			}
+
+			PlatformFile.IterateDirectoryStat(*Directory.Path, [&](const TCHAR* Path, const FFileStatData& StatData)
+			{
+				const int64 Id = Visitor(WorkerIndex, Directory.Id, Path, StatData);
+
+				if (StatData.bIsDirectory)
+				{
+					PendingDirectories.Increment();
+
+					FWorkerQueue& OwnQueue = Queues[WorkerIndex];
+					FScopeLock ScopeLock(&OwnQueue.Lock);
+					OwnQueue.Directories.Add(FPendingDirectory{Path, Id});
+				}
+
+				return true;
+			});
+
+			PendingDirectories.Decrement();
+		}
+	});
+}
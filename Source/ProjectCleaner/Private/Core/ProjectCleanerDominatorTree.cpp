@@ -0,0 +1,182 @@
+﻿// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+#include "Core/ProjectCleanerDominatorTree.h"
+
+void FProjectCleanerDominatorTree::Build(const FProjectCleanerDependencyGraph& Graph, const TArray<int32>& Roots, const EProjectCleanerDependencyType EdgeTypes, const TArray<int64>& NodeSizes)
+{
+	Reset();
+
+	const int32 NumNodes = Graph.GetNumNodes();
+	SuperRoot = NumNodes;
+	
+	ImmediateDominators.Init(INDEX_NONE, NumNodes + 1);
+	PostOrderNumbers.Init(INDEX_NONE, NumNodes + 1);
+	RetainedSizes.Init(0, NumNodes + 1);
+
+	const auto ForEachFollowedEdge = [&](const TArrayView<const int32> Nodes, const TArrayView<const EProjectCleanerDependencyType> Types, auto&& Callback)
+	{
+		for (int32 Index = 0; Index < Nodes.Num(); ++Index)
+		{
+			if (EnumHasAnyFlags(Types[Index], EdgeTypes))
+			{
+				Callback(Nodes[Index]);
+			}
+		}
+	};
+
+	// 1) iterative depth first search from every root, giving post order numbers
+	TBitArray<> Visited{false, NumNodes};
+	TBitArray<> IsRoot{false, NumNodes};
+	TArray<int32> PostOrder;
+	PostOrder.Reserve(NumNodes + 1);
+
+	struct FStackEntry
+	{
+		int32 Node;
+		int32 NextEdge;
+	};
+	TArray<FStackEntry> Stack;
+
+	const auto VisitFromRoot = [&](const int32 Root)
+	{
+		if (Visited[Root]) return;
+		
+		Visited[Root] = true;
+		IsRoot[Root] = true;
+		Stack.Add(FStackEntry{Root, 0});
+
+		while (Stack.Num() > 0)
+		{
+			FStackEntry& Top = Stack.Last();
+			const TArrayView<const int32> Deps = Graph.GetDependencies(Top.Node);
+			const TArrayView<const EProjectCleanerDependencyType> DepTypes = Graph.GetDependencyTypes(Top.Node);
+
+			bool bPushed = false;
+			while (Top.NextEdge < Deps.Num())
+			{
+				const int32 Edge = Top.NextEdge++;
+				const int32 Dep = Deps[Edge];
+				if (Visited[Dep] || !EnumHasAnyFlags(DepTypes[Edge], EdgeTypes)) continue;
+
+				Visited[Dep] = true;
+				Stack.Add(FStackEntry{Dep, 0});
+				bPushed = true;
+				break;
+			}
+
+			if (bPushed) continue;
+
+			PostOrderNumbers[Top.Node] = PostOrder.Add(Top.Node);
+			Stack.Pop(false);
+		}
+	};
+
+	for (const int32 Root : Roots)
+	{
+		VisitFromRoot(Root);
+	}
+
+	// 2) covering game nodes not reachable from roots, top level ones first, so cycles below them are not taken as roots
+	for (int32 Node = 0; Node < NumNodes; ++Node)
+	{
+		if (Visited[Node] || !Graph.IsGameNode(Node)) continue;
+
+		bool bHasReferencers = false;
+		ForEachFollowedEdge(Graph.GetReferencers(Node), Graph.GetReferencerTypes(Node), [&](const int32)
+		{
+			bHasReferencers = true;
+		});
+
+		if (!bHasReferencers)
+		{
+			VisitFromRoot(Node);
+		}
+	}
+
+	for (int32 Node = 0; Node < NumNodes; ++Node)
+	{
+		if (!Visited[Node] && Graph.IsGameNode(Node))
+		{
+			VisitFromRoot(Node);
+		}
+	}
+	
+	PostOrderNumbers[SuperRoot] = PostOrder.Add(SuperRoot);
+	ImmediateDominators[SuperRoot] = SuperRoot;
+
+	// 3) iterating in reverse post order until dominators stop changing
+	bool bChanged = true;
+	while (bChanged)
+	{
+		bChanged = false;
+		for (int32 Index = PostOrder.Num() - 2; Index >= 0; --Index)
+		{
+			const int32 Node = PostOrder[Index];
+			int32 NewDominator = IsRoot[Node] ? SuperRoot : INDEX_NONE;
+
+			ForEachFollowedEdge(Graph.GetReferencers(Node), Graph.GetReferencerTypes(Node), [&](const int32 Ref)
+			{
+				if (ImmediateDominators[Ref] == INDEX_NONE) return;
+				
+				NewDominator = NewDominator == INDEX_NONE ? Ref : Intersect(Ref, NewDominator);
+			});
+
+			if (ImmediateDominators[Node] != NewDominator)
+			{
+				ImmediateDominators[Node] = NewDominator;
+				bChanged = true;
+			}
+		}
+	}
+
+	// 4) dominator always has bigger post order number, so children summed up before their dominators
+	for (int32 Index = 0; Index < PostOrder.Num() - 1; ++Index)
+	{
+		const int32 Node = PostOrder[Index];
+		RetainedSizes[Node] += NodeSizes.IsValidIndex(Node) ? NodeSizes[Node] : 0;
+		RetainedSizes[ImmediateDominators[Node]] += RetainedSizes[Node];
+	}
+}
+
+void FProjectCleanerDominatorTree::Reset()
+{
+	SuperRoot = INDEX_NONE;
+	ImmediateDominators.Reset();
+	PostOrderNumbers.Reset();
+	RetainedSizes.Reset();
+}
+
+int32 FProjectCleanerDominatorTree::GetImmediateDominator(const int32 Node) const
+{
+	if (!IsInTree(Node)) return INDEX_NONE;
+
+	const int32 Dominator = ImmediateDominators[Node];
+	return Dominator == SuperRoot ? INDEX_NONE : Dominator;
+}
+
+int64 FProjectCleanerDominatorTree::GetRetainedSize(const int32 Node) const
+{
+	return IsInTree(Node) ? RetainedSizes[Node] : 0;
+}
+
+bool FProjectCleanerDominatorTree::IsInTree(const int32 Node) const
+{
+	return Node >= 0 && Node < SuperRoot && ImmediateDominators[Node] != INDEX_NONE;
+}
+
+int32 FProjectCleanerDominatorTree::Intersect(int32 NodeA, int32 NodeB) const
+{
+	while (NodeA != NodeB)
+	{
+		while (PostOrderNumbers[NodeA] < PostOrderNumbers[NodeB])
+		{
+			NodeA = ImmediateDominators[NodeA];
+		}
+		while (PostOrderNumbers[NodeB] < PostOrderNumbers[NodeA])
+		{
+			NodeB = ImmediateDominators[NodeB];
+		}
+	}
+
+	return NodeA;
+}
@@ -0,0 +1,294 @@
+﻿// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+#include "Core/ProjectCleanerFileSnapshot.h"
+#include "Core/ProjectCleanerDirectoryWalker.h"
+// Engine Headers
+#include "GenericPlatform/GenericPlatformFile.h"
+
+namespace ProjectCleanerFileSnapshot
+{
+	struct FWorkerEntries
+	{
+		TArray<FProjectCleanerFileEntry> Files;
+		TArray<FProjectCleanerDirectoryEntry> Directories;
+
+		// parent ids as given by walker, resolved to snapshot indices after walk
+		TArray<int64> FileParentIds;
+		TArray<int64> DirectoryParentIds;
+	};
+
+	// directory id encodes worker that visited directory and its index in worker entries
+	int64 MakeDirectoryId(const int32 WorkerIndex, const int32 LocalIndex)
+	{
+		return (static_cast<int64>(WorkerIndex) << 32) | static_cast<int64>(LocalIndex);
+	}
+}
+
+void FProjectCleanerFileSnapshot::Build(const FString& InRootDir)
+{
+	using namespace ProjectCleanerFileSnapshot;
+	
+	Reset();
+
+	RootDir = InRootDir;
+	RootDir.RemoveFromEnd(TEXT("/"));
+
+	FProjectCleanerDirectoryEntry& RootEntry = Directories.AddDefaulted_GetRef();
+	RootEntry.Path = RootDir;
+
+	const int32 NumWorkers = FProjectCleanerDirectoryWalker::GetNumWorkers();
+	TArray<FWorkerEntries> WorkersEntries;
+	WorkersEntries.SetNum(NumWorkers);
+
+	FProjectCleanerDirectoryWalker::Walk(RootDir, INDEX_NONE, NumWorkers, [&](const int32 WorkerIndex, const int64 ParentId, const TCHAR* Path, const FFileStatData& StatData)
+	{
+		FWorkerEntries& Entries = WorkersEntries[WorkerIndex];
+		if (StatData.bIsDirectory)
+		{
+			FProjectCleanerDirectoryEntry& Entry = Entries.Directories.AddDefaulted_GetRef();
+			Entry.Path = Path;
+			Entry.ModificationTime = StatData.ModificationTime;
+			Entries.DirectoryParentIds.Add(ParentId);
+			
+			return MakeDirectoryId(WorkerIndex, Entries.Directories.Num() - 1);
+		}
+
+		FProjectCleanerFileEntry& Entry = Entries.Files.AddDefaulted_GetRef();
+		Entry.Path = Path;
+		Entry.Size = StatData.FileSize;
+		Entry.ModificationTime = StatData.ModificationTime;
+		Entries.FileParentIds.Add(ParentId);
+
+		return static_cast<int64>(INDEX_NONE);
+	});
+
+	// merging worker entries, directory of worker N placed after all directories of previous workers
+	TArray<int32> DirectoryOffsets;
+	DirectoryOffsets.SetNum(NumWorkers);
+	int32 NumDirectories = Directories.Num();
+	int32 NumFiles = 0;
+	for (int32 WorkerIndex = 0; WorkerIndex < NumWorkers; ++WorkerIndex)
+	{
+		DirectoryOffsets[WorkerIndex] = NumDirectories;
+		NumDirectories += WorkersEntries[WorkerIndex].Directories.Num();
+		NumFiles += WorkersEntries[WorkerIndex].Files.Num();
+	}
+
+	const auto ResolveParentId = [&](const int64 ParentId)
+	{
+		if (ParentId == INDEX_NONE) return 0;
+		
+		const int32 WorkerIndex = static_cast<int32>(ParentId >> 32);
+		const int32 LocalIndex = static_cast<int32>(ParentId & 0xFFFFFFFF);
+		return DirectoryOffsets[WorkerIndex] + LocalIndex;
+	};
+
+	TArray<FProjectCleanerDirectoryEntry> MergedDirectories = MoveTemp(Directories);
+	MergedDirectories.Reserve(NumDirectories);
+	for (auto& Entries : WorkersEntries)
+	{
+		for (int32 Index = 0; Index < Entries.Directories.Num(); ++Index)
+		{
+			Entries.Directories[Index].ParentIndex = ResolveParentId(Entries.DirectoryParentIds[Index]);
+			MergedDirectories.Add(MoveTemp(Entries.Directories[Index]));
+		}
+	}
+
+	// workers visit directories in arbitrary order, so reordering them breadth first.
+	// every parent placed before its children and siblings placed sequentially,
+	// which allows aggregating values with single reverse pass
+	TArray<int32> SubDirectoriesOffsets;
+	SubDirectoriesOffsets.SetNumZeroed(NumDirectories + 1);
+	for (int32 Index = 1; Index < NumDirectories; ++Index)
+	{
+		++SubDirectoriesOffsets[MergedDirectories[Index].ParentIndex + 1];
+	}
+	for (int32 Index = 0; Index < NumDirectories; ++Index)
+	{
+		SubDirectoriesOffsets[Index + 1] += SubDirectoriesOffsets[Index];
+	}
+
+	TArray<int32> SubDirectories;
+	SubDirectories.SetNumUninitialized(FMath::Max(NumDirectories - 1, 0));
+	{
+		TArray<int32> InsertPositions(SubDirectoriesOffsets.GetData(), NumDirectories);
+		for (int32 Index = 1; Index < NumDirectories; ++Index)
+		{
+			SubDirectories[InsertPositions[MergedDirectories[Index].ParentIndex]++] = Index;
+		}
+	}
+
+	TArray<int32> Order;
+	TArray<int32> NewIndices;
+	Order.Reserve(NumDirectories);
+	NewIndices.SetNumUninitialized(NumDirectories);
+	Order.Add(0);
+	for (int32 OrderIndex = 0; OrderIndex < Order.Num(); ++OrderIndex)
+	{
+		const int32 Current = Order[OrderIndex];
+		NewIndices[Current] = OrderIndex;
+		for (int32 Offset = SubDirectoriesOffsets[Current]; Offset < SubDirectoriesOffsets[Current + 1]; ++Offset)
+		{
+			Order.Add(SubDirectories[Offset]);
+		}
+	}
+
+	Directories.Reserve(NumDirectories);
+	for (const int32 OldIndex : Order)
+	{
+		FProjectCleanerDirectoryEntry& Directory = Directories.Add_GetRef(MoveTemp(MergedDirectories[OldIndex]));
+		if (Directory.ParentIndex != INDEX_NONE)
+		{
+			Directory.ParentIndex = NewIndices[Directory.ParentIndex];
+		}
+	}
+
+	Files.Reserve(NumFiles);
+	for (auto& Entries : WorkersEntries)
+	{
+		for (int32 Index = 0; Index < Entries.Files.Num(); ++Index)
+		{
+			Entries.Files[Index].DirectoryIndex = NewIndices[ResolveParentId(Entries.FileParentIds[Index])];
+			Files.Add(MoveTemp(Entries.Files[Index]));
+		}
+	}
+
+	// child counts
+	for (int32 Index = 1; Index < Directories.Num(); ++Index)
+	{
+		FProjectCleanerDirectoryEntry& Parent = Directories[Directories[Index].ParentIndex];
+		if (Parent.NumSubDirectories == 0)
+		{
+			Parent.FirstSubDirectoryIndex = Index;
+		}
+		++Parent.NumSubDirectories;
+	}
+
+	for (const auto& File : Files)
+	{
+		FProjectCleanerDirectoryEntry& Directory = Directories[File.DirectoryIndex];
+		++Directory.NumFiles;
+		Directory.SizeRecursive += File.Size;
+	}
+
+	// recursive values, children always placed after parent, so going backwards is bottom up pass
+	for (auto& Directory : Directories)
+	{
+		Directory.NumFilesRecursive = Directory.NumFiles;
+	}
+
+	for (int32 Index = Directories.Num() - 1; Index > 0; --Index)
+	{
+		const FProjectCleanerDirectoryEntry& Directory = Directories[Index];
+		FProjectCleanerDirectoryEntry& Parent = Directories[Directory.ParentIndex];
+		Parent.NumFilesRecursive += Directory.NumFilesRecursive;
+		Parent.SizeRecursive += Directory.SizeRecursive;
+	}
+}
+
+void FProjectCleanerFileSnapshot::Reset()
+{
+	RootDir.Empty();
+	Files.Empty();
+	Directories.Empty();
+}
+
+const FString& FProjectCleanerFileSnapshot::GetRootDir() const
+{
+	return RootDir;
+}
+
+const TArray<FProjectCleanerFileEntry>& FProjectCleanerFileSnapshot::GetFiles() const
+{
+	return Files;
+}
+
+const TArray<FProjectCleanerDirectoryEntry>& FProjectCleanerFileSnapshot::GetDirectories() const
+{
+	return Directories;
+}
+
+int32 FProjectCleanerFileSnapshot::FindDirectory(const FString& Path) const
+{
+	if (Directories.Num() == 0) return INDEX_NONE;
+	if (!Path.StartsWith(RootDir)) return INDEX_NONE;
+
+	TArray<FString> PathParts;
+	Path.RightChop(RootDir.Len()).ParseIntoArray(PathParts, TEXT("/"), true);
+
+	// going down from root, comparing only last path part of subdirectories
+	int32 Current = 0;
+	for (const auto& PathPart : PathParts)
+	{
+		const FProjectCleanerDirectoryEntry& Directory = Directories[Current];
+		const int32 ExpectedLen = Directory.Path.Len() + 1 + PathPart.Len();
+
+		int32 Found = INDEX_NONE;
+		for (int32 Index = Directory.FirstSubDirectoryIndex; Index < Directory.FirstSubDirectoryIndex + Directory.NumSubDirectories; ++Index)
+		{
+			if (Directories[Index].bRemoved) continue;
+			
+			const FString& SubDirectoryPath = Directories[Index].Path;
+			if (SubDirectoryPath.Len() == ExpectedLen && SubDirectoryPath.EndsWith(PathPart))
+			{
+				Found = Index;
+				break;
+			}
+		}
+
+		if (Found == INDEX_NONE) return INDEX_NONE;
+		
+		Current = Found;
+	}
+
+	return Current;
+}
+
+int32 FProjectCleanerFileSnapshot::RemoveFiles(const TSet<FString>& Paths, TArray<int32>& OutEmptiedDirectories)
+{
+	OutEmptiedDirectories.Reset();
+	if (Paths.Num() == 0) return 0;
+
+	const int32 NumFilesBefore = Files.Num();
+	Files.RemoveAll([&](const FProjectCleanerFileEntry& File)
+	{
+		if (!Paths.Contains(File.Path)) return false;
+
+		FProjectCleanerDirectoryEntry& Directory = Directories[File.DirectoryIndex];
+		--Directory.NumFiles;
+		
+		// going up to root, updating totals of every ancestor
+		for (int32 Current = File.DirectoryIndex; Current != INDEX_NONE; Current = Directories[Current].ParentIndex)
+		{
+			FProjectCleanerDirectoryEntry& Ancestor = Directories[Current];
+			--Ancestor.NumFilesRecursive;
+			Ancestor.SizeRecursive -= File.Size;
+			
+			if (Ancestor.NumFilesRecursive == 0)
+			{
+				OutEmptiedDirectories.Add(Current);
+			}
+		}
+		
+		return true;
+	});
+
+	return NumFilesBefore - Files.Num();
+}
+
+void FProjectCleanerFileSnapshot::RemoveDirectory(const int32 Index)
+{
+	TArray<int32> Stack;
+	Stack.Add(Index);
+	
+	while (Stack.Num() > 0)
+	{
+		FProjectCleanerDirectoryEntry& Directory = Directories[Stack.Pop(false)];
+		Directory.bRemoved = true;
+		
+		for (int32 SubDirectory = Directory.FirstSubDirectoryIndex; SubDirectory < Directory.FirstSubDirectoryIndex + Directory.NumSubDirectories; ++SubDirectory)
+		{
+			Stack.Add(SubDirectory);
+		}
+	}
+}
@@ -0,0 +1,125 @@
+﻿// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+#include "Core/ProjectCleanerIndirectCache.h"
+// Engine Headers
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Misc/Paths.h"
+#include "Serialization/Archive.h"
+
+namespace ProjectCleanerIndirectCache
+{
+	static constexpr uint32 Magic = 0x50434943; // "PCIC"
+	// must be increased every time when entry layout or scanner rules changes
+	static constexpr int32 Version = 2;
+}
+
+FArchive& operator<<(FArchive& Ar, FProjectCleanerIndirectReference& Reference)
+{
+	Ar << Reference.Path;
+	Ar << Reference.Line;
+	return Ar;
+}
+
+FArchive& operator<<(FArchive& Ar, FProjectCleanerIndirectCacheEntry& Entry)
+{
+	Ar << Entry.Size;
+	Ar << Entry.ModificationTime;
+	Ar << Entry.Hash;
+	Ar << Entry.References;
+	return Ar;
+}
+
+bool FProjectCleanerIndirectCache::Load(const FString& CacheFilePath)
+{
+	using namespace ProjectCleanerIndirectCache;
+	
+	Entries.Reset();
+
+	const TUniquePtr<FArchive> Reader{IFileManager::Get().CreateFileReader(*CacheFilePath, FILEREAD_Silent)};
+	if (!Reader) return false;
+
+	uint32 FileMagic = 0;
+	int32 FileVersion = 0;
+	*Reader << FileMagic;
+	*Reader << FileVersion;
+	if (Reader->IsError() || FileMagic != Magic || FileVersion != Version) return false;
+
+	*Reader << Entries;
+
+	// corrupted or truncated cache is just ignored, all files will be scanned again
+	if (!Reader->Close() || Reader->IsError())
+	{
+		Entries.Reset();
+		return false;
+	}
+
+	return true;
+}
+
+bool FProjectCleanerIndirectCache::Save(const FString& CacheFilePath) const
+{
+	using namespace ProjectCleanerIndirectCache;
+	
+	const TUniquePtr<FArchive> Writer{IFileManager::Get().CreateFileWriter(*CacheFilePath, FILEWRITE_Silent)};
+	if (!Writer) return false;
+
+	uint32 FileMagic = Magic;
+	int32 FileVersion = Version;
+	*Writer << FileMagic;
+	*Writer << FileVersion;
+	*Writer << const_cast<TMap<FString, FProjectCleanerIndirectCacheEntry>&>(Entries);
+
+	return Writer->Close() && !Writer->IsError();
+}
+
+bool FProjectCleanerIndirectCache::ScanFile(const FString& FilePath, FProjectCleanerIndirectCacheEntry& OutEntry) const
+{
+	const FFileStatData StatData = FPlatformFileManager::Get().GetPlatformFile().GetStatData(*FilePath);
+	if (!StatData.bIsValid || StatData.bIsDirectory) return false;
+
+	OutEntry.Size = StatData.FileSize;
+	OutEntry.ModificationTime = StatData.ModificationTime.GetTicks();
+	OutEntry.References.Reset();
+
+	const FProjectCleanerIndirectCacheEntry* CachedEntry = Entries.Find(FilePath);
+	
+	// same size and modification time, file not touched since last scan, so not even reading it
+	if (CachedEntry && CachedEntry->Size == OutEntry.Size && CachedEntry->ModificationTime == OutEntry.ModificationTime)
+	{
+		OutEntry.Hash = CachedEntry->Hash;
+		OutEntry.References = CachedEntry->References;
+		return true;
+	}
+
+	// same size, but touched (checkout, branch switch etc.), hashing is cheaper than scanning, so content compared by hash first
+	uint64 Hash = 0;
+	if (CachedEntry && CachedEntry->Size == OutEntry.Size && FProjectCleanerIndirectScanner::HashFile(FilePath, Hash) && Hash == CachedEntry->Hash)
+	{
+		OutEntry.Hash = Hash;
+		OutEntry.References = CachedEntry->References;
+		return true;
+	}
+
+	// file changed, it is read and scanned only once while hashing
+	Hash = 0;
+	if (!FProjectCleanerIndirectScanner::ScanFile(FilePath, OutEntry.References, &Hash)) return false;
+
+	OutEntry.Hash = Hash;
+	return true;
+}
+
+void FProjectCleanerIndirectCache::Reset()
+{
+	Entries.Reset();
+}
+
+void FProjectCleanerIndirectCache::Add(const FString& FilePath, FProjectCleanerIndirectCacheEntry&& Entry)
+{
+	Entries.Add(FilePath, MoveTemp(Entry));
+}
+
+FString FProjectCleanerIndirectCache::GetDefaultCacheFilePath()
+{
+	return FPaths::ProjectSavedDir() / TEXT("ProjectCleaner") / TEXT("IndirectReferences.bin");
+}
@@ -0,0 +1,261 @@
+﻿// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+#include "Core/ProjectCleanerIndirectScanner.h"
+// Engine Headers
+#include "Async/MappedFileHandle.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Hash/CityHash.h"
+#include "Misc/FileHelper.h"
+
+namespace ProjectCleanerIndirectScanner
+{
+	static constexpr ANSICHAR Pattern[] = "/Game/";
+	static constexpr int64 PatternLen = UE_ARRAY_COUNT(Pattern) - 1;
+}
+
+bool FProjectCleanerIndirectScanner::ScanFile(const FString& FilePath, TArray<FProjectCleanerIndirectReference>& OutReferences, uint64* OutContentHash)
+{
+	if (ScanMappedFile(FilePath, OutReferences, OutContentHash)) return true;
+
+	return ScanStreamedFile(FilePath, OutReferences, OutContentHash);
+}
+
+void FProjectCleanerIndirectScanner::ScanContent(const uint8* Data, const int64 Size, TArray<FProjectCleanerIndirectReference>& OutReferences)
+{
+	// UTF-16 files are rare (some ini files), converting them to UTF-8 first
+	if (IsUTF16(Data, Size))
+	{
+		FString Text;
+		FFileHelper::BufferToString(Text, Data, static_cast<int32>(Size));
+		const FTCHARToUTF8 ConvertedText{*Text};
+		ScanBuffer(reinterpret_cast<const uint8*>(ConvertedText.Get()), ConvertedText.Length(), OutReferences);
+		return;
+	}
+	
+	ScanBuffer(Data, Size, OutReferences);
+}
+
+uint64 FProjectCleanerIndirectScanner::HashBlock(const uint8* Data, const int64 Size, const uint64 Hash)
+{
+	return CityHash64WithSeed(reinterpret_cast<const char*>(Data), static_cast<uint32>(Size), Hash);
+}
+
+bool FProjectCleanerIndirectScanner::HashFile(const FString& FilePath, uint64& OutContentHash)
+{
+	const TUniquePtr<IFileHandle> FileHandle{FPlatformFileManager::Get().GetPlatformFile().OpenRead(*FilePath)};
+	if (!FileHandle) return false;
+
+	const int64 FileSize = FileHandle->Size();
+	uint64 Hash = 0;
+	
+	TArray<uint8> Block;
+	Block.SetNumUninitialized(FMath::Min(BlockSize, FileSize));
+	for (int64 Offset = 0; Offset < FileSize; Offset += BlockSize)
+	{
+		const int64 ReadSize = FMath::Min(BlockSize, FileSize - Offset);
+		if (!FileHandle->Read(Block.GetData(), ReadSize)) return false;
+
+		Hash = HashBlock(Block.GetData(), ReadSize, Hash);
+	}
+
+	OutContentHash = Hash;
+	return true;
+}
+
+bool FProjectCleanerIndirectScanner::ScanMappedFile(const FString& FilePath, TArray<FProjectCleanerIndirectReference>& OutReferences, uint64* OutContentHash)
+{
+	// not all platforms support mapping, also empty files can't be mapped
+	const TUniquePtr<IMappedFileHandle> MappedFile{FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*FilePath)};
+	if (!MappedFile || MappedFile->GetFileSize() <= 0) return false;
+
+	const TUniquePtr<IMappedFileRegion> MappedRegion{MappedFile->MapRegion(0, MappedFile->GetFileSize(), true)};
+	if (!MappedRegion) return false;
+
+	const uint8* Data = MappedRegion->GetMappedPtr();
+	const int64 Size = MappedRegion->GetMappedSize();
+	
+	if (OutContentHash)
+	{
+		uint64 Hash = 0;
+		for (int64 Offset = 0; Offset < Size; Offset += BlockSize)
+		{
+			Hash = HashBlock(Data + Offset, FMath::Min(BlockSize, Size - Offset), Hash);
+		}
+		*OutContentHash = Hash;
+	}
+
+	ScanContent(Data, Size, OutReferences);
+	return true;
+}
+
+bool FProjectCleanerIndirectScanner::ScanStreamedFile(const FString& FilePath, TArray<FProjectCleanerIndirectReference>& OutReferences, uint64* OutContentHash)
+{
+	const TUniquePtr<IFileHandle> FileHandle{FPlatformFileManager::Get().GetPlatformFile().OpenRead(*FilePath)};
+	if (!FileHandle) return false;
+
+	const int64 FileSize = FileHandle->Size();
+	uint64 Hash = 0;
+
+	// buffer holds unfinished tail of previous block + next block
+	TArray<uint8> Buffer;
+	Buffer.SetNumUninitialized(FMath::Min(BlockSize, FileSize) * 2);
+	
+	int64 Carry = 0;
+	int32 Line = 1;
+	for (int64 Offset = 0; Offset < FileSize; Offset += BlockSize)
+	{
+		const int64 ReadSize = FMath::Min(BlockSize, FileSize - Offset);
+		uint8* Block = Buffer.GetData() + Carry;
+		if (!FileHandle->Read(Block, ReadSize)) return false;
+
+		Hash = HashBlock(Block, ReadSize, Hash);
+
+		// UTF-16 files are small config files, they can't be scanned by blocks, so reading whole file instead
+		if (Offset == 0 && IsUTF16(Block, ReadSize))
+		{
+			TArray<uint8> Content;
+			if (!FFileHelper::LoadFileToArray(Content, *FilePath, FILEREAD_Silent)) return false;
+
+			ScanContent(Content.GetData(), Content.Num(), OutReferences);
+			if (OutContentHash)
+			{
+				Hash = 0;
+				for (int64 ContentOffset = 0; ContentOffset < Content.Num(); ContentOffset += BlockSize)
+				{
+					Hash = HashBlock(Content.GetData() + ContentOffset, FMath::Min<int64>(BlockSize, Content.Num() - ContentOffset), Hash);
+				}
+				*OutContentHash = Hash;
+			}
+			return true;
+		}
+
+		const uint8* Begin = Buffer.GetData();
+		const uint8* End = Block + ReadSize;
+		
+		// path can't contain non path chars, so it can't cross last one of them, rest is scanned together with next block
+		const uint8* ScanEnd = End;
+		if (Offset + ReadSize < FileSize)
+		{
+			while (ScanEnd > Begin && IsPathChar(ScanEnd[-1]))
+			{
+				--ScanEnd;
+			}
+
+			// whole buffer is single path (binary junk), nothing to keep
+			if (ScanEnd == Begin || End - ScanEnd > BlockSize)
+			{
+				ScanEnd = End;
+			}
+		}
+
+		ScanBuffer(Begin, ScanEnd - Begin, OutReferences, Line);
+		Line += CountLines(Begin, ScanEnd);
+
+		Carry = End - ScanEnd;
+		if (Carry > 0)
+		{
+			FMemory::Memmove(Buffer.GetData(), ScanEnd, Carry);
+		}
+	}
+
+	if (OutContentHash)
+	{
+		*OutContentHash = Hash;
+	}
+
+	return true;
+}
+
+bool FProjectCleanerIndirectScanner::IsUTF16(const uint8* Data, const int64 Size)
+{
+	return Size >= 2 && (
+		(Data[0] == 0xFF && Data[1] == 0xFE) ||
+		(Data[0] == 0xFE && Data[1] == 0xFF)
+	);
+}
+
+void FProjectCleanerIndirectScanner::ScanBuffer(const uint8* Data, const int64 Size, TArray<FProjectCleanerIndirectReference>& OutReferences, const int32 FirstLine)
+{
+	using namespace ProjectCleanerIndirectScanner;
+
+	if (!Data || Size < PatternLen) return;
+
+	const uint8* End = Data + Size;
+	const uint8* Cursor = Data;
+	// lines counted lazily, only between found paths
+	const uint8* LineCursor = Data;
+	int32 Line = FirstLine;
+
+	while (End - Cursor >= PatternLen)
+	{
+		// memchr is vectorized by CRT, so skipping text without slashes is very cheap
+		const uint8* Found = static_cast<const uint8*>(memchr(Cursor, Pattern[0], End - Cursor));
+		if (!Found || End - Found < PatternLen) break;
+
+		if (FMemory::Memcmp(Found, Pattern, PatternLen) != 0)
+		{
+			Cursor = Found + 1;
+			continue;
+		}
+
+		// path ends at first char that can't be part of object path (quotes, whitespace, brackets etc.)
+		const uint8* TokenEnd = Found + PatternLen;
+		while (TokenEnd < End && IsPathChar(*TokenEnd))
+		{
+			++TokenEnd;
+		}
+
+		Cursor = TokenEnd;
+
+		// trimming trailing dots and slashes, for example when path is at end of sentence in comment
+		while (TokenEnd > Found + PatternLen && (TokenEnd[-1] == '.' || TokenEnd[-1] == '/'))
+		{
+			--TokenEnd;
+		}
+
+		if (TokenEnd == Found + PatternLen) continue;
+
+		Line += CountLines(LineCursor, Found);
+		LineCursor = Found;
+
+		const FUTF8ToTCHAR ConvertedPath{reinterpret_cast<const ANSICHAR*>(Found), static_cast<int32>(TokenEnd - Found)};
+		
+		FProjectCleanerIndirectReference& Reference = OutReferences.AddDefaulted_GetRef();
+		Reference.Path = FString{ConvertedPath.Length(), ConvertedPath.Get()};
+		Reference.Line = Line;
+	}
+}
+
+bool FProjectCleanerIndirectScanner::IsPathChar(const uint8 Char)
+{
+	// non ASCII bytes are part of multibyte UTF-8 chars, which are allowed in asset names
+	if (Char >= 0x80) return true;
+	if (FCharAnsi::IsAlnum(Char)) return true;
+
+	switch (Char)
+	{
+		case '/':
+		case '.':
+		case '_':
+		case '-':
+		case '+':
+			return true;
+		default:
+			return false;
+	}
+}
+
+int32 FProjectCleanerIndirectScanner::CountLines(const uint8* Begin, const uint8* End)
+{
+	int32 Count = 0;
+	while (Begin < End)
+	{
+		const uint8* NewLine = static_cast<const uint8*>(memchr(Begin, '\n', End - Begin));
+		if (!NewLine) break;
+		
+		++Count;
+		Begin = NewLine + 1;
+	}
+
+	return Count;
+}
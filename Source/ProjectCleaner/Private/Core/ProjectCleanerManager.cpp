@@ -3,6 +3,7 @@
 #include "Core/ProjectCleanerManager.h"
 #include "StructsContainer.h"
 #include "UI/ProjectCleanerNotificationManager.h"
+#include "Core/ProjectCleanerQuarantine.h"
 // Engine Headers
 #include "AssetRegistryModule.h"
 #include "Misc/ScopedSlowTask.h"
@@ -43,6 +44,32 @@ void FProjectCleanerManager::Update()
 	}
 }
 
+void FProjectCleanerManager::CheckInterruptedDeletion()
+{
+	// asked once per editor session, not after every analysis
+	if (bInterruptedDeletionChecked) return;
+	bInterruptedDeletionChecked = true;
+	
+	if (!DataManager.HasInterruptedDeletion()) return;
+	
+	const auto ConfirmationWindowStatus = ProjectCleanerNotificationManager::ShowConfirmationWindow(
+		FText::FromString(FStandardCleanerText::ResumeDeletionTitle),
+		FText::FromString(FStandardCleanerText::ResumeDeletionContent)
+	);
+	if (ProjectCleanerNotificationManager::IsConfirmationWindowCanceled(ConfirmationWindowStatus))
+	{
+		DataManager.DiscardInterruptedDeletion();
+		return;
+	}
+	
+	DataManager.ResumeInterruptedDeletion();
+	
+	if (OnCleanerManagerUpdated.IsBound())
+	{
+		OnCleanerManagerUpdated.Execute();
+	}
+}
+
 void FProjectCleanerManager::ExcludeSelectedAssets(const TArray<FAssetData>& Assets)
 {
 	DataManager.ExcludeSelectedAssets(Assets);
@@ -152,6 +179,11 @@ int32 FProjectCleanerManager::DeleteSelectedAssets(const TArray<FAssetData>& Ass
 		);
 	}
 
+	if (OnCleanerManagerUpdated.IsBound())
+	{
+		OnCleanerManagerUpdated.Execute();
+	}
+
 	return DeletedAssetsNum;
 }
 
@@ -179,7 +211,7 @@ int32 FProjectCleanerManager::DeleteAllUnusedAssets()
 	
 	if (CleanerConfigs->bAutomaticallyDeleteEmptyFolders)
 	{
-		DeleteEmptyFolders();
+		DeleteEmptyFolders(false);
 	}
 	
 	// todo:ashe23 This part is hacky
@@ -210,9 +242,70 @@ int32 FProjectCleanerManager::DeleteAllUnusedAssets()
 	return DeleteAssetsNum;
 }
 
+int32 FProjectCleanerManager::QuarantineAllUnusedAssets()
+{
+	const int32 UnusedAssetsNum = DataManager.GetUnusedAssets().Num();
+	const int32 QuarantinedAssetsNum = DataManager.QuarantineAllUnusedAssets();
+
+	ProjectCleanerNotificationManager::AddTransient(
+		FText::FromString(UnusedAssetsNum == QuarantinedAssetsNum ? FStandardCleanerText::UnusedAssetsSuccessfullyQuarantined : FStandardCleanerText::FailedToQuarantineSomeAssets),
+		UnusedAssetsNum == QuarantinedAssetsNum ? SNotificationItem::CS_Success : SNotificationItem::CS_Fail,
+		10.0f
+	);
+	
+	if (CleanerConfigs->bAutomaticallyDeleteEmptyFolders)
+	{
+		DeleteEmptyFolders(false);
+	}
+	
+	if (OnCleanerManagerUpdated.IsBound())
+	{
+		OnCleanerManagerUpdated.Execute();
+	}
+
+	return QuarantinedAssetsNum;
+}
+
+int32 FProjectCleanerManager::RestoreLatestQuarantine()
+{
+	const FString QuarantineDir = FProjectCleanerQuarantine::GetLatestQuarantineDir();
+	if (QuarantineDir.IsEmpty())
+	{
+		ProjectCleanerNotificationManager::AddTransient(
+			FText::FromString(FStandardCleanerText::NoQuarantineToRestore),
+			SNotificationItem::CS_Fail,
+			3.0f
+		);
+		
+		return 0;
+	}
+
+	const int32 RestoredFilesNum = DataManager.RestoreQuarantine(QuarantineDir);
+	if (RestoredFilesNum > 0)
+	{
+		ProjectCleanerNotificationManager::AddTransient(
+			FText::FromString(FStandardCleanerText::QuarantineSuccessfullyRestored),
+			SNotificationItem::CS_Success,
+			5.0f
+		);
+	}
+	
+	if (OnCleanerManagerUpdated.IsBound())
+	{
+		OnCleanerManagerUpdated.Execute();
+	}
+	
+	return RestoredFilesNum;
+}
+
 int32 FProjectCleanerManager::DeleteEmptyFolders()
 {
-	const int32 DeletedFoldersNum = DataManager.DeleteEmptyFolders();
+	return DeleteEmptyFolders(true);
+}
+
+int32 FProjectCleanerManager::DeleteEmptyFolders(const bool bRescanContent)
+{
+	const int32 DeletedFoldersNum = DataManager.DeleteEmptyFolders(bRescanContent);
 
 	if (DeletedFoldersNum > 0)
 	{
@@ -256,11 +349,16 @@ const TSet<FName>& FProjectCleanerManager::GetNonEngineFiles() const
 	return DataManager.GetNonEngineFiles();
 }
 
-const TMap<FAssetData, FIndirectAsset>& FProjectCleanerManager::GetIndirectAssets() const
+const FIndirectAssets& FProjectCleanerManager::GetIndirectAssets() const
 {
 	return DataManager.GetIndirectAssets();
 }
 
+const TArray<FAssetData>& FProjectCleanerManager::GetEditorOnlyUsedAssets() const
+{
+	return DataManager.GetEditorOnlyUsedAssets();
+}
+
 const TSet<FName>& FProjectCleanerManager::GetEmptyFolders() const
 {
 	return DataManager.GetEmptyFolders();
@@ -271,6 +369,31 @@ const TSet<FName>& FProjectCleanerManager::GetPrimaryAssetClasses() const
 	return DataManager.GetPrimaryAssetClasses();
 }
 
+int64 FProjectCleanerManager::GetAllAssetsSize() const
+{
+	return DataManager.GetAllAssetsSize();
+}
+
+int64 FProjectCleanerManager::GetUnusedAssetsSize() const
+{
+	return DataManager.GetUnusedAssetsSize();
+}
+
+int64 FProjectCleanerManager::GetRetainedSize(const FAssetData& Asset) const
+{
+	return DataManager.GetRetainedSize(Asset);
+}
+
+const TArray<FAssetData>& FProjectCleanerManager::GetLargestUnusedRoots() const
+{
+	return DataManager.GetLargestUnusedRoots();
+}
+
+bool FProjectCleanerManager::GetUsageChain(const FAssetData& Asset, TArray<FName>& OutChain, EProjectCleanerUsedAssetRoot& OutRoot) const
+{
+	return DataManager.GetUsageChain(Asset, OutChain, OutRoot);
+}
+
 UCleanerConfigs* FProjectCleanerManager::GetCleanerConfigs() const
 {
 	return CleanerConfigs;
@@ -0,0 +1,160 @@
+﻿// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+#include "Core/ProjectCleanerQuarantine.h"
+#include "ProjectCleaner.h"
+// Engine Headers
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+TArray<FString> FProjectCleanerQuarantine::MoveToQuarantine(const TArray<FString>& Files, FString& OutQuarantineDir)
+{
+	TArray<FString> MovedFiles;
+	const FString ProjectDir = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir());
+
+	// timestamp names sorted same way as creation time, suffix added if quarantined twice in same second
+	const FString TimestampDir = GetQuarantineRootDir() / FDateTime::Now().ToString(TEXT("%Y.%m.%d-%H.%M.%S"));
+	OutQuarantineDir = TimestampDir;
+	for (int32 Suffix = 1; IFileManager::Get().DirectoryExists(*OutQuarantineDir); ++Suffix)
+	{
+		OutQuarantineDir = FString::Printf(TEXT("%s_%d"), *TimestampDir, Suffix);
+	}
+	
+	if (!IFileManager::Get().MakeDirectory(*OutQuarantineDir, true))
+	{
+		UE_LOG(LogProjectCleaner, Error, TEXT("Failed to create quarantine folder %s"), *OutQuarantineDir);
+		return MovedFiles;
+	}
+	
+	TArray<FString> RelativePaths;
+	RelativePaths.Reserve(Files.Num());
+	for (const auto& File : Files)
+	{
+		FString RelativePath = FPaths::ConvertRelativePathToFull(File);
+		if (!FPaths::MakePathRelativeTo(RelativePath, *ProjectDir) || RelativePath.StartsWith(TEXT("..")))
+		{
+			UE_LOG(LogProjectCleaner, Warning, TEXT("%s is outside of project directory, skipped"), *File);
+			continue;
+		}
+		
+		RelativePaths.Add(MoveTemp(RelativePath));
+	}
+	
+	if (!FFileHelper::SaveStringArrayToFile(RelativePaths, *GetManifestFilePath(OutQuarantineDir)))
+	{
+		UE_LOG(LogProjectCleaner, Error, TEXT("Failed to write quarantine manifest in %s"), *OutQuarantineDir);
+		return MovedFiles;
+	}
+
+	MovedFiles.Reserve(RelativePaths.Num());
+	for (const auto& RelativePath : RelativePaths)
+	{
+		const FString OriginalFile = ProjectDir / RelativePath;
+		if (IFileManager::Get().Move(*(OutQuarantineDir / RelativePath), *OriginalFile, false, true))
+		{
+			MovedFiles.Add(OriginalFile);
+		}
+		else
+		{
+			UE_LOG(LogProjectCleaner, Warning, TEXT("Failed to move %s to quarantine"), *OriginalFile);
+		}
+	}
+
+	return MovedFiles;
+}
+
+TArray<FString> FProjectCleanerQuarantine::Restore(const FString& QuarantineDir)
+{
+	TArray<FString> RestoredFiles;
+	
+	TArray<FString> RelativePaths;
+	if (!FFileHelper::LoadFileToStringArray(RelativePaths, *GetManifestFilePath(QuarantineDir)))
+	{
+		UE_LOG(LogProjectCleaner, Error, TEXT("Quarantine manifest not found in %s"), *QuarantineDir);
+		return RestoredFiles;
+	}
+	
+	const FString ProjectDir = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir());
+	bool bAllRestored = true;
+	
+	RestoredFiles.Reserve(RelativePaths.Num());
+	for (const auto& RelativePath : RelativePaths)
+	{
+		const FString QuarantinedFile = QuarantineDir / RelativePath;
+		
+		// manifest written before moving, so files that were not moved are missing here
+		if (!IFileManager::Get().FileExists(*QuarantinedFile)) continue;
+
+		const FString OriginalFile = ProjectDir / RelativePath;
+		if (IFileManager::Get().Move(*OriginalFile, *QuarantinedFile, false, true))
+		{
+			RestoredFiles.Add(OriginalFile);
+		}
+		else
+		{
+			UE_LOG(LogProjectCleaner, Warning, TEXT("Failed to restore %s, file already exists or is not writable"), *OriginalFile);
+			bAllRestored = false;
+		}
+	}
+
+	if (bAllRestored)
+	{
+		IFileManager::Get().DeleteDirectory(*QuarantineDir, false, true);
+	}
+
+	return RestoredFiles;
+}
+
+void FProjectCleanerQuarantine::GetQuarantineDirs(TArray<FString>& OutQuarantineDirs)
+{
+	OutQuarantineDirs.Reset();
+	
+	const FString RootDir = GetQuarantineRootDir();
+	IFileManager::Get().FindFiles(OutQuarantineDirs, *(RootDir / TEXT("*")), false, true);
+
+	// names are "<timestamp>" or "<timestamp>_<suffix>", suffix compared as number, so "_10" goes after "_2"
+	const auto SplitName = [](const FString& Name, FString& OutTimestamp, int32& OutSuffix)
+	{
+		FString Suffix;
+		if (Name.Split(TEXT("_"), &OutTimestamp, &Suffix, ESearchCase::CaseSensitive, ESearchDir::FromEnd))
+		{
+			OutSuffix = FCString::Atoi(*Suffix);
+			return;
+		}
+
+		OutTimestamp = Name;
+		OutSuffix = 0;
+	};
+	OutQuarantineDirs.Sort([&](const FString& A, const FString& B)
+	{
+		FString TimestampA, TimestampB;
+		int32 SuffixA, SuffixB;
+		SplitName(A, TimestampA, SuffixA);
+		SplitName(B, TimestampB, SuffixB);
+
+		return TimestampA == TimestampB ? SuffixA < SuffixB : TimestampA < TimestampB;
+	});
+	
+	for (auto& QuarantineDir : OutQuarantineDirs)
+	{
+		QuarantineDir = RootDir / QuarantineDir;
+	}
+}
+
+FString FProjectCleanerQuarantine::GetLatestQuarantineDir()
+{
+	TArray<FString> QuarantineDirs;
+	GetQuarantineDirs(QuarantineDirs);
+
+	return QuarantineDirs.Num() > 0 ? QuarantineDirs.Last() : FString{};
+}
+
+FString FProjectCleanerQuarantine::GetQuarantineRootDir()
+{
+	return FPaths::ConvertRelativePathToFull(FPaths::ProjectSavedDir() / TEXT("ProjectCleaner") / TEXT("Quarantine"));
+}
+
+FString FProjectCleanerQuarantine::GetManifestFilePath(const FString& QuarantineDir)
+{
+	return QuarantineDir / TEXT("Manifest.txt");
+}
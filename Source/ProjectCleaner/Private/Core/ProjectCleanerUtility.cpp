@@ -12,7 +12,6 @@
 #include "Misc/FileHelper.h"
 #include "Misc/ScopedSlowTask.h"
 #include "Editor/ContentBrowser/Public/ContentBrowserModule.h"
-#include "Internationalization/Regex.h"
 
 int64 ProjectCleanerUtility::GetTotalSize(const TArray<FAssetData>& Assets)
 {
@@ -87,40 +86,6 @@ FString ProjectCleanerUtility::ConvertInternalToAbsolutePath(const FString& InPa
 	return ConvertPathInternal(FString{ "/Game/" }, ProjectContentDirAbsPath, Path);
 }
 
-bool ProjectCleanerUtility::FindEmptyFoldersInPath(const FString& FolderPath, TSet<FName>& EmptyFolders)
-{
-	bool IsSubFoldersEmpty = true;
-	TArray<FString> SubFolders;
-	IFileManager::Get().FindFiles(SubFolders, *FolderPath, false, true);
-
-	for (const auto& SubFolder : SubFolders)
-	{
-		// "*" needed for unreal`s IFileManager class, without it , its not working.
-		auto NewPath = FolderPath;
-		NewPath.RemoveFromEnd(TEXT("*"));
-		NewPath += SubFolder / TEXT("*");
-		if (FindEmptyFoldersInPath(NewPath, EmptyFolders))
-		{
-			NewPath.RemoveFromEnd(TEXT("*"));
-			EmptyFolders.Add(*NewPath);
-		}
-		else
-		{
-			IsSubFoldersEmpty = false;
-		}
-	}
-
-	TArray<FString> FilesInFolder;
-	IFileManager::Get().FindFiles(FilesInFolder, *FolderPath, true, false);
-
-	if (IsSubFoldersEmpty && FilesInFolder.Num() == 0)
-	{
-		return true;
-	}
-
-	return false;
-}
-
 bool ProjectCleanerUtility::IsEngineExtension(const FString& Extension)
 {
 	return Extension.Equals("uasset") || Extension.Equals("umap");
@@ -131,16 +96,6 @@ bool ProjectCleanerUtility::IsUnderMegascansFolder(const FAssetData& AssetData)
 	return AssetData.PackagePath.ToString().StartsWith(TEXT("/Game/MSPresets"));
 }
 
-bool ProjectCleanerUtility::HasIndirectlyUsedAssets(const FString& FileContent)
-{
-	if (FileContent.IsEmpty()) return false;
-	
-	// search any sub string that has asset package path in it
-	static FRegexPattern Pattern(TEXT(R"(\/Game(.*)\b)"));
-	FRegexMatcher Matcher(Pattern, FileContent);
-	return Matcher.FindNext();
-}
-
 FString ProjectCleanerUtility::ConvertPathInternal(const FString& From, const FString To, const FString& Path)
 {
 	return Path.Replace(*From, *To, ESearchCase::IgnoreCase);
@@ -8,6 +8,9 @@
 #include "ToolMenus.h"
 #include "AssetToolsModule.h"
 #include "AssetRegistry/AssetRegistryModule.h"
+#include "ContentBrowserModule.h"
+#include "Framework/MultiBox/MultiBoxBuilder.h"
+#include "Misc/MessageDialog.h"
 
 DEFINE_LOG_CATEGORY(LogProjectCleaner);
 
@@ -41,6 +44,12 @@ void FProjectCleanerModule::StartupModule()
 		FOnSpawnTab::CreateRaw(this, &FProjectCleanerModule::OnSpawnPluginTab))
 		.SetDisplayName(LOCTEXT("FProjectCleanerTabTitle", "ProjectCleaner"))
 		.SetMenuType(ETabSpawnerMenuType::Hidden);
+
+	// "Why is this asset used" action in content browser asset context menu
+	FContentBrowserModule& ContentBrowserModule = FModuleManager::LoadModuleChecked<FContentBrowserModule>(TEXT("ContentBrowser"));
+	auto& AssetContextMenuExtenders = ContentBrowserModule.GetAllAssetViewContextMenuExtenders();
+	AssetContextMenuExtenders.Add(FContentBrowserMenuExtender_SelectedAssets::CreateRaw(this, &FProjectCleanerModule::OnExtendAssetContextMenu));
+	AssetContextMenuExtenderHandle = AssetContextMenuExtenders.Last().GetHandle();
 }
 
 void FProjectCleanerModule::ShutdownModule()
@@ -50,6 +59,15 @@ void FProjectCleanerModule::ShutdownModule()
 	FProjectCleanerStyle::Shutdown();
 	FProjectCleanerCommands::Unregister();
 	FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(ProjectCleanerTabName);
+
+	if (FModuleManager::Get().IsModuleLoaded(TEXT("ContentBrowser")))
+	{
+		FContentBrowserModule& ContentBrowserModule = FModuleManager::GetModuleChecked<FContentBrowserModule>(TEXT("ContentBrowser"));
+		ContentBrowserModule.GetAllAssetViewContextMenuExtenders().RemoveAll([&](const FContentBrowserMenuExtender_SelectedAssets& Delegate)
+		{
+			return Delegate.GetHandle() == AssetContextMenuExtenderHandle;
+		});
+	}
 }
 
 bool FProjectCleanerModule::IsGameModule() const
@@ -76,10 +94,105 @@ void FProjectCleanerModule::RegisterMenus()
 void FProjectCleanerModule::PluginButtonClicked()
 {
 	CleanerManager.Update();
+	CleanerManager.CheckInterruptedDeletion();
 	
 	FGlobalTabmanager::Get()->TryInvokeTab(ProjectCleanerTabName);
 }
 
+TSharedRef<FExtender> FProjectCleanerModule::OnExtendAssetContextMenu(const TArray<FAssetData>& SelectedAssets)
+{
+	TSharedRef<FExtender> Extender = MakeShared<FExtender>();
+	if (SelectedAssets.Num() != 1) return Extender;
+
+	const FAssetData Asset = SelectedAssets[0];
+	Extender->AddMenuExtension(
+		TEXT("GetAssetActions"),
+		EExtensionHook::After,
+		nullptr,
+		FMenuExtensionDelegate::CreateLambda([this, Asset](FMenuBuilder& MenuBuilder)
+		{
+			MenuBuilder.AddMenuEntry(
+				LOCTEXT("WhyAssetUsed", "Why Is This Asset Used?"),
+				LOCTEXT("WhyAssetUsedTooltip", "Shows chain of assets that keeps this asset from being unused"),
+				FSlateIcon(),
+				FUIAction(FExecuteAction::CreateRaw(this, &FProjectCleanerModule::ShowUsageChain, Asset))
+			);
+		})
+	);
+
+	return Extender;
+}
+
+void FProjectCleanerModule::ShowUsageChain(const FAssetData Asset)
+{
+	// project not scanned yet or asset created since last analysis, it is not in dependency graph
+	if (!CleanerManager.GetDataManager().IsAssetScanned(Asset))
+	{
+		CleanerManager.Update();
+	}
+
+	// still not in graph, so asset is in folder that is not scanned (Developers folder etc.), nothing known about its usage
+	if (!CleanerManager.GetDataManager().IsAssetScanned(Asset))
+	{
+		FMessageDialog::Open(
+			EAppMsgType::Ok,
+			FText::Format(LOCTEXT("AssetNotScanned", "{0} is not scanned. Check scan settings and re-run analysis."), FText::FromName(Asset.PackageName))
+		);
+		return;
+	}
+
+	TArray<FName> Chain;
+	EProjectCleanerUsedAssetRoot Root;
+	if (!CleanerManager.GetUsageChain(Asset, Chain, Root))
+	{
+		FMessageDialog::Open(
+			EAppMsgType::Ok,
+			FText::Format(LOCTEXT("AssetNotUsed", "{0} is not used."), FText::FromName(Asset.PackageName))
+		);
+		return;
+	}
+
+	FText RootText;
+	switch (Root)
+	{
+		case EProjectCleanerUsedAssetRoot::PrimaryAsset:
+			RootText = LOCTEXT("RootPrimaryAsset", "primary asset");
+			break;
+		case EProjectCleanerUsedAssetRoot::IndirectReference:
+			RootText = LOCTEXT("RootIndirectReference", "used in source code or config files");
+			break;
+		case EProjectCleanerUsedAssetRoot::ExternalReferencer:
+			RootText = LOCTEXT("RootExternalReferencer", "referenced outside of Game folder");
+			break;
+		case EProjectCleanerUsedAssetRoot::DeveloperFolder:
+			RootText = LOCTEXT("RootDeveloperFolder", "in Developers folder");
+			break;
+		case EProjectCleanerUsedAssetRoot::Excluded:
+			RootText = LOCTEXT("RootExcluded", "excluded");
+			break;
+		default:
+			RootText = LOCTEXT("RootUnknown", "unknown");
+			break;
+	}
+
+	FString ChainText;
+	for (int32 Index = 0; Index < Chain.Num(); ++Index)
+	{
+		ChainText += FString::Printf(TEXT("%s%s\n"), *FString::ChrN(Index * 2, TEXT(' ')), *Chain[Index].ToString());
+	}
+
+	FMessageDialog::Open(
+		EAppMsgType::Ok,
+		FText::Format(
+			LOCTEXT("AssetUsageChain", "{0} is used because {1} is {2}:\n\n{3}"),
+			FText::FromName(Asset.PackageName),
+			FText::FromName(Chain[0]),
+			RootText,
+			FText::FromString(ChainText)
+		)
+	);
+}
+
 TSharedRef<SDockTab> FProjectCleanerModule::OnSpawnPluginTab(const FSpawnTabArgs& SpawnTabArgs)
 {
 	return SNew(SDockTab).TabRole(ETabRole::MajorTab)
@@ -124,18 +124,26 @@ void SProjectCleanerIndirectAssetsUI::UpdateUI()
 {
 	if (!CleanerManager) return;
 
+	const FIndirectAssets& Indirect = CleanerManager->GetIndirectAssets();
+	const TArray<FAssetData>& AllAssets = CleanerManager->GetAllAssets();
+	
 	IndirectAssets.Reset();
-	IndirectAssets.Reserve(CleanerManager->GetIndirectAssets().Num());
 
-	for (const auto& IndirectFile : CleanerManager->GetIndirectAssets())
+	// every usage gets its own row, so user can see all places where asset used
+	for (const auto& AssetUsages : Indirect.Usages)
 	{
-		const auto IndirectAsset = NewObject<UIndirectAsset>();
-		IndirectAsset->AssetName = IndirectFile.Key.AssetName.ToString();
-		IndirectAsset->AssetPath = IndirectFile.Value.RelativePath.ToString();
-		IndirectAsset->FilePath = IndirectFile.Value.File;
-		IndirectAsset->LineNum = IndirectFile.Value.Line;
-		
-		IndirectAssets.Add(IndirectAsset);
+		const FAssetData& AssetData = AllAssets[AssetUsages.Key];
+		for (const auto& Usage : AssetUsages.Value)
+		{
+			const auto IndirectAsset = NewObject<UIndirectAsset>();
+			IndirectAsset->AssetName = AssetData.AssetName.ToString();
+			IndirectAsset->AssetPath = AssetData.PackagePath.ToString();
+			IndirectAsset->FilePath = Indirect.Files[Usage.FileIndex];
+			IndirectAsset->LineNum = Usage.Line;
+			IndirectAsset->AssetData = AssetData;
+			
+			IndirectAssets.Add(IndirectAsset);
+		}
 	}
 	
 	if (ListView.IsValid())
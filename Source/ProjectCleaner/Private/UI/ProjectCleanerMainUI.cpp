@@ -125,6 +125,33 @@ void SProjectCleanerMainUI::Construct(const FArguments& InArgs)
 									]
 								]
 								+ SVerticalBox::Slot()
+								.Padding(FMargin{ 20.0f, 0.0f, 20.0f, 20.0f })
+								.AutoHeight()
+								[
+									SNew(SHorizontalBox)
+									+ SHorizontalBox::Slot()
+									.FillWidth(1.0f)
+									.Padding(FMargin{ 0.0f, 0.0f, 20.0f, 0.0f })
+									[
+										SNew(SButton)
+										.HAlign(HAlign_Center)
+										.VAlign(VAlign_Center)
+										.Text(FText::FromString("Quarantine Unused Assets"))
+										.ToolTipText(FText::FromString("Move unused assets to Saved/ProjectCleaner/Quarantine instead of deleting them. Source control is not notified, moved files reported as missing until restored"))
+										.OnClicked_Raw(this, &SProjectCleanerMainUI::OnQuarantineUnusedAssetsBtnClick)
+									]
+									+ SHorizontalBox::Slot()
+									.FillWidth(1.0f)
+									.Padding(FMargin{ 20.0f, 0.0f, 0.0f, 0.0f })
+									[
+										SNew(SButton)
+										.HAlign(HAlign_Center)
+										.VAlign(VAlign_Center)
+										.Text(FText::FromString("Restore Last Quarantine"))
+										.OnClicked_Raw(this, &SProjectCleanerMainUI::OnRestoreQuarantineBtnClick)
+									]
+								]
+								+ SVerticalBox::Slot()
 								.Padding(FMargin{20.0f, 5.0f})
 								.AutoHeight()
 								[
@@ -393,4 +420,47 @@ FReply SProjectCleanerMainUI::OnDeleteEmptyFolderClick() const
 	return FReply::Handled();
 }
 
+FReply SProjectCleanerMainUI::OnQuarantineUnusedAssetsBtnClick() const
+{
+	if (CleanerManager->GetUnusedAssets().Num() == 0)
+	{
+		ProjectCleanerNotificationManager::AddTransient(
+			FText::FromString(FStandardCleanerText::NoAssetsToDelete),
+			SNotificationItem::ECompletionState::CS_Fail,
+			3.0f
+		);
+	
+		return FReply::Handled();
+	}
+	
+	const auto ConfirmationWindowStatus = ProjectCleanerNotificationManager::ShowConfirmationWindow(
+		FText::FromString(FStandardCleanerText::AssetsQuarantineWindowTitle),
+		FText::FromString(FStandardCleanerText::AssetsQuarantineWindowContent)
+	);
+	if (ProjectCleanerNotificationManager::IsConfirmationWindowCanceled(ConfirmationWindowStatus))
+	{
+		return FReply::Handled();
+	}
+	
+	CleanerManager->QuarantineAllUnusedAssets();
+	
+	return FReply::Handled();
+}
+
+FReply SProjectCleanerMainUI::OnRestoreQuarantineBtnClick() const
+{
+	const auto ConfirmationWindowStatus = ProjectCleanerNotificationManager::ShowConfirmationWindow(
+		FText::FromString(FStandardCleanerText::QuarantineRestoreWindowTitle),
+		FText::FromString(FStandardCleanerText::QuarantineRestoreWindowContent)
+	);
+	if (ProjectCleanerNotificationManager::IsConfirmationWindowCanceled(ConfirmationWindowStatus))
+	{
+		return FReply::Handled();
+	}
+	
+	CleanerManager->RestoreLatestQuarantine();
+
+	return FReply::Handled();
+}
+
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
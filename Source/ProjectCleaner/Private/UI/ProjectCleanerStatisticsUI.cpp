@@ -3,7 +3,6 @@
 #include "UI/ProjectCleanerStatisticsUI.h"
 #include "UI/ProjectCleanerStyle.h"
 #include "Core/ProjectCleanerManager.h"
-#include "Core/ProjectCleanerUtility.h"
 // Engine Headers
 #include "Widgets/Notifications/SProgressBar.h"
 
@@ -135,6 +134,30 @@ void SProjectCleanerStatisticsUI::Construct(const FArguments& InArgs)
 			.MaxHeight(MaxHeight)
 			.Padding(FMargin{0.0, 0.0f, 0.0f, 3.0f})
 			.HAlign(HAlign_Center)
+			[
+				SNew(SHorizontalBox)
+				.ToolTipText(LOCTEXT("stat_largest_unused_root_tooltip", "Unused asset that frees most space when deleted, together with all assets used only by it"))
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				[
+					SNew(STextBlock)
+					.AutoWrapText(true)
+					.Font(FProjectCleanerStyle::Get().GetFontStyle("ProjectCleaner.Font.Light20"))
+					.Text(LOCTEXT("stat_largest_unused_root", "Largest Unused Root - "))
+				]
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				[
+					SNew(STextBlock)
+					.AutoWrapText(false)
+					.Font(FProjectCleanerStyle::Get().GetFontStyle("ProjectCleaner.Font.Light20"))
+					.Text_Raw(this, &SProjectCleanerStatisticsUI::GetLargestUnusedRoot)
+				]
+			]
+			+ SVerticalBox::Slot()
+			.MaxHeight(MaxHeight)
+			.Padding(FMargin{0.0, 0.0f, 0.0f, 3.0f})
+			.HAlign(HAlign_Center)
 			[
 				SNew(SHorizontalBox)
 				+ SHorizontalBox::Slot()
@@ -181,6 +204,30 @@ void SProjectCleanerStatisticsUI::Construct(const FArguments& InArgs)
 			.MaxHeight(MaxHeight)
 			.Padding(FMargin{0.0, 0.0f, 0.0f, 3.0f})
 			.HAlign(HAlign_Center)
+			[
+				SNew(SHorizontalBox)
+				.ToolTipText(LOCTEXT("stat_editor_only_used_assets_num_tooltip", "Assets used only through editor only references, they are not cooked"))
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				[
+					SNew(STextBlock)
+					.AutoWrapText(true)
+					.Font(FProjectCleanerStyle::Get().GetFontStyle("ProjectCleaner.Font.Light20"))
+					.Text(LOCTEXT("stat_editor_only_used_assets_num", "Editor Only Used Assets - "))
+				]
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				[
+					SNew(STextBlock)
+					.AutoWrapText(true)
+					.Font(FProjectCleanerStyle::Get().GetFontStyle("ProjectCleaner.Font.Light20"))
+					.Text_Raw(this, &SProjectCleanerStatisticsUI::GetEditorOnlyUsedAssetsNum)
+				]
+			]
+			+ SVerticalBox::Slot()
+			.MaxHeight(MaxHeight)
+			.Padding(FMargin{0.0, 0.0f, 0.0f, 3.0f})
+			.HAlign(HAlign_Center)
 			[
 				SNew(SHorizontalBox)
 				+ SHorizontalBox::Slot()
@@ -303,14 +350,27 @@ FText SProjectCleanerStatisticsUI::GetUnusedAssetsNum() const
 
 FText SProjectCleanerStatisticsUI::GetTotalProjectSize() const
 {
-	const int64 TotalProjectSize = ProjectCleanerUtility::GetTotalSize(CleanerManager->GetAllAssets());
-	return FText::AsMemory(TotalProjectSize);
+	return FText::AsMemory(CleanerManager->GetAllAssetsSize());
 }
 
 FText SProjectCleanerStatisticsUI::GetTotalUnusedAssetsSize() const
 {
-	const int64 UnusedSize = ProjectCleanerUtility::GetTotalSize(CleanerManager->GetUnusedAssets());
-	return FText::AsMemory(UnusedSize);
+	return FText::AsMemory(CleanerManager->GetUnusedAssetsSize());
+}
+
+FText SProjectCleanerStatisticsUI::GetLargestUnusedRoot() const
+{
+	const TArray<FAssetData>& Roots = CleanerManager->GetLargestUnusedRoots();
+	if (Roots.Num() == 0)
+	{
+		return LOCTEXT("stat_largest_unused_root_none", "None");
+	}
+
+	return FText::Format(
+		LOCTEXT("stat_largest_unused_root_value", "{0} ({1})"),
+		FText::FromName(Roots[0].AssetName),
+		FText::AsMemory(CleanerManager->GetRetainedSize(Roots[0]))
+	);
 }
 
 FText SProjectCleanerStatisticsUI::GetNonEngineFilesNum() const
@@ -323,6 +383,11 @@ FText SProjectCleanerStatisticsUI::GetIndirectAssetsNum() const
 	return FText::AsNumber(CleanerManager->GetIndirectAssets().Num());
 }
 
+FText SProjectCleanerStatisticsUI::GetEditorOnlyUsedAssetsNum() const
+{
+	return FText::AsNumber(CleanerManager->GetEditorOnlyUsedAssets().Num());
+}
+
 FText SProjectCleanerStatisticsUI::GetEmptyFoldersNum() const
 {
 	return FText::AsNumber(CleanerManager->GetEmptyFolders().Num());
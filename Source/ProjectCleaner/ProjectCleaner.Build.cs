@@ -50,7 +50,8 @@ public class ProjectCleaner : ModuleRules
 				"UnrealEd",
 				"ToolMenus",
 				"AssetTools",
-				"AssetRegistry"
+				"AssetRegistry",
+				"SourceControl"
 			}
 		);
 
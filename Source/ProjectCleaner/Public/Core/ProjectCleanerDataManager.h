@@ -3,12 +3,18 @@
 #pragma once
 
 #include "StructsContainer.h"
+#include "Core/ProjectCleanerDependencyGraph.h"
+#include "Core/ProjectCleanerDominatorTree.h"
+#include "Core/ProjectCleanerFileSnapshot.h"
+#include "Core/ProjectCleanerIndirectCache.h"
 #include "CoreMinimal.h"
 
 struct FAssetData;
 class FAssetToolsModule;
 class FAssetRegistryModule;
 class IPlatformFile;
+class FProjectCleanerDeletionJournal;
+struct FScopedSlowTask;
 
 class FProjectCleanerDataManager : public ICleanerUIActions
 {
@@ -38,6 +44,39 @@ public:
 	virtual int32 DeleteAllUnusedAssets() override;
 	virtual int32 DeleteEmptyFolders() override;
 
+	/**
+	 * @brief Deletes empty folders
+	 * @param bRescanContent Scans content folder before searching empty folders. Not needed right after assets deletion, because snapshot patched by it
+	 * @return int32 Number of deleted folders
+	 */
+	int32 DeleteEmptyFolders(const bool bRescanContent);
+
+	/**
+	 * @brief Moves package files of unused assets to quarantine folder, instead of deleting them. Loaded assets skipped
+	 * @return Number of quarantined assets
+	 */
+	int32 QuarantineAllUnusedAssets();
+
+	/**
+	 * @brief Moves package files from given quarantine folder back to project
+	 * @param QuarantineDir Quarantine folder
+	 * @return Number of restored files
+	 */
+	int32 RestoreQuarantine(const FString& QuarantineDir);
+
+	/**
+	 * @brief Checks if deletion journal left by interrupted (crashed) deletion exists
+	 * @return bool
+	 */
+	bool HasInterruptedDeletion() const;
+
+	/**
+	 * @brief Continues interrupted deletion from last committed bucket. Project must be analyzed first, assets that became used skipped
+	 * @return Number of deleted assets
+	 */
+	int32 ResumeInterruptedDeletion();
+	void DiscardInterruptedDeletion();
+
 	// getters
 	const FAssetRegistryModule* GetAssetRegistry() const;
 	const TArray<FAssetData>& GetAllAssets() const;
@@ -47,52 +86,180 @@ public:
 	const TSet<FName>& GetNonEngineFiles() const;
 	const TSet<FName>& GetEmptyFolders() const;
 	const TSet<FName>& GetPrimaryAssetClasses() const;
-	const TMap<FAssetData, FIndirectAsset>& GetIndirectAssets() const;
+	const FIndirectAssets& GetIndirectAssets() const;
+	const TArray<FAssetData>& GetEditorOnlyUsedAssets() const;
+	int64 GetAllAssetsSize() const;
+	int64 GetUnusedAssetsSize() const;
+	int64 GetRetainedSize(const FAssetData& Asset) const;
+	const TArray<FAssetData>& GetLargestUnusedRoots() const;
+	const TArray<FAssetData>& GetLargestUsedRoots() const;
+
+	/**
+	 * @brief Returns shortest chain of packages that keeps given asset used, walking cached parents (no graph search)
+	 * @param Asset Asset to check
+	 * @param OutChain Package names starting from root and ending with given asset package
+	 * @param OutRoot Why root of chain is used
+	 * @return false if asset is not used
+	 */
+	bool GetUsageChain(const FAssetData& Asset, TArray<FName>& OutChain, EProjectCleanerUsedAssetRoot& OutRoot) const;
+
+	/**
+	 * @brief Checks if given asset was part of last analysis. Assets created after it or in not scanned folders are not
+	 * @param Asset Asset to check
+	 * @return bool
+	 */
+	bool IsAssetScanned(const FAssetData& Asset) const;
 	
 	// setters
 	void SetCleanerConfigs(const UCleanerConfigs* CleanerConfigs);
 	void SetSilentMode(const bool SilentMode);
 	void SetScanDeveloperContents(const bool bScan);
+	void SetForceSerialTraversal(const bool bForceSerial);
+	void SetFollowedDependencyTypes(const EProjectCleanerDependencyType DependencyTypes);
+
+	/**
+	 * @brief Combines dependency types followed by analysis from separate options, hard references always followed
+	 * @param bSoft Follow soft references
+	 * @param bEditorOnly Follow editor only references
+	 * @param bManagement Follow management references
+	 * @param bSearchableName Follow searchable name references
+	 * @return EProjectCleanerDependencyType
+	 */
+	static EProjectCleanerDependencyType MakeFollowedDependencyTypes(const bool bSoft, const bool bEditorOnly, const bool bManagement, const bool bSearchableName);
+	void SetDeleteWithoutLoading(const bool bWithoutLoading);
+	void SetDeletionMemoryLimit(const int32 MemoryLimitMB);
 	
 private:
 	
 	void FixupRedirectors() const;
 	void FindAllAssets();
+	void BuildDependencyGraph();
+	void ScanContentDirectory();
 	void FindInvalidFilesAndAssets();
 	void FindIndirectAssets();
 	void FindEmptyFolders(const bool bScanDevelopersContent);
 	void FindPrimaryAssetClasses();
 	void FindAssetsWithExternalReferencers();
 	void FindUnusedAssets();
+	void FindEditorOnlyUsedAssets(const TSet<FName>& UsedAssets, const TBitArray<>& UsedNodes);
+	void FindRetainedSizes(const TSet<FName>& UsedAssets, const TBitArray<>& UsedNodes);
 	void FindUsedAssets(TSet<FName>& UsedAssets);
-	void FindUsedAssetsDependencies(const TSet<FName>& UsedAssets, TSet<FName>& UsedAssetsDeps) const;
+	void FindUsedAssetsDependencies(const TSet<FName>& UsedAssets, TBitArray<>& UsedNodes);
 	void FindExcludedAssets(TSet<FName>& UsedAssets);
-	void FillBucketWithAssets(TArray<FAssetData>& Bucket, const int32 BucketSize);
+	void MarkAsUsed(TSet<FName>& UsedAssets, const FName& PackageName, const EProjectCleanerUsedAssetRoot Root);
+	int32 DeleteUnusedAssets(const TArray<FAssetData>& Assets);
 	bool PrepareBucketForDeletion(const TArray<FAssetData>& Bucket, TArray<UObject*>& LoadedAssets);
 	int32 DeleteBucket(const TArray<UObject*>& LoadedAssets);
+
+	/**
+	 * @brief Checks bucket against dependency graph, so rest of it can be deleted without force delete
+	 * @param Bucket Assets to delete, held assets removed from it
+	 * @param PendingPackages Packages waiting for deletion in next buckets
+	 * @param DeletedPackages Packages deleted in previous buckets
+	 * @param OutHeldAssets Assets referenced by packages that are not deleted yet
+	 * @param OutBlockedPackages Held packages that referenced by packages that stay in project, with their referencer
+	 */
+	void ValidateBucket(TArray<FAssetData>& Bucket, const TSet<FName>& PendingPackages, const TSet<FName>& DeletedPackages, TArray<FAssetData>& OutHeldAssets, TMap<FName, FName>& OutBlockedPackages) const;
+
+	/**
+	 * @brief Deletes assets held back by bucket validation after all buckets, in buckets too. Blocked assets force deleted at the end
+	 * @param DeferredAssets Assets referenced by packages that was waiting for deletion, in deletion order
+	 * @param BlockedAssets Assets referenced by packages that stay in project
+	 * @param BlockedPackages Blocked packages with their referencer
+	 * @param PendingPackages Packages waiting for deletion
+	 * @param DeletedPackages Packages deleted in previous buckets
+	 * @param BucketSize Size of first bucket
+	 * @param DeletionJournal Journal processed held assets committed to
+	 * @param DeleteSlowTask Deletion progress
+	 * @param bOutAborted Set if some assets failed to load
+	 * @return int32 Number of deleted assets
+	 */
+	int32 DeleteHeldAssets(const TArray<FAssetData>& DeferredAssets, TArray<FAssetData>& BlockedAssets, TMap<FName, FName>& BlockedPackages, TSet<FName>& PendingPackages, TSet<FName>& DeletedPackages, int32 BucketSize, FProjectCleanerDeletionJournal& DeletionJournal, FScopedSlowTask& DeleteSlowTask, bool& bOutAborted);
+	void FindAssetsToDeleteWithoutLoading(TArray<FAssetData>& Bucket, TArray<FAssetData>& OutAssets) const;
+	int32 DeletePackageFiles(const TArray<FAssetData>& Assets) const;
+	void GetPackageFiles(const TArray<FAssetData>& Assets, TArray<FString>& OutFiles) const;
+	int32 GetNumRemovedAssets(const TArray<FAssetData>& Assets) const;
+
+	/**
+	 * @brief Calculates size of next bucket from measurements of last one, so buckets fit into memory limit and take reasonable time
+	 * @param BucketSize Size of last bucket
+	 * @param BucketNum Number of assets in last bucket
+	 * @param BucketMemory Memory growth while processing last bucket
+	 * @param BucketTime Time of processing last bucket, in seconds
+	 * @param UsedMemory Memory used after last bucket
+	 * @return int32
+	 */
+	int32 GetNextBucketSize(const int32 BucketSize, const int32 BucketNum, const int64 BucketMemory, const double BucketTime, const int64 UsedMemory) const;
+	
+	/**
+	 * @brief Patches analysis results after deletion, instead of analyzing project again. Deleted assets removed, sizes and empty folders updated
+	 * @param Assets Assets that were tried to delete, those with package files still on disk are kept
+	 */
+	void RemoveDeletedAssets(const TArray<FAssetData>& Assets);
 	void CleanupAfterDelete();
 
 	/* Check Functions */
 	bool IsExcludedByClass(const FAssetData& AssetData) const;
 	bool IsExcludedByPath(const FAssetData& AssetData) const;
+
+	int64 GetTotalSize(const TArray<FAssetData>& Assets) const;
+
+	/* Lookup Functions */
+	const FAssetData* FindAssetByPath(const FName& Path) const;
+	int32 FindAssetIndexByPath(const FName& Path) const;
+	int32 FindAssetIndexByIndirectReference(const FString& Path) const;
 	
 	/* Data Containers */
 	TArray<FAssetData> AllAssets;
 	TArray<FAssetData> UnusedAssets;
 	TArray<FAssetData> PrimaryAssets;
 	TArray<FAssetData> UserExcludedAssets;
-	TArray<FAssetData> AssetsWithExternalRefs;
+	/* Bit per graph node, set if package referenced from other mount point (engine, plugins etc.) */
+	TBitArray<> NodesWithExternalRefs;
+	/* Assets that used only through editor only dependencies, so they are not cooked */
+	TArray<FAssetData> EditorOnlyUsedAssets;
 	TSet<FName> CorruptedAssets;
 	TSet<FName> NonEngineFiles;
 	TSet<FName> EmptyFolders;
 	TSet<FName> PrimaryAssetClasses;
 	TSet<FName> ExcludedAssets;
-	TMap<FAssetData, FIndirectAsset> IndirectAssets;
+	FIndirectAssets IndirectAssets;
+
+	/* Lookup Index (built once in FindAllAssets, keys are object paths and package names, values are indices in AllAssets) */
+	TMap<FName, int32> AssetIndexByPath;
+
+	/* File System Snapshot of Content directory (built once per analysis) */
+	FProjectCleanerFileSnapshot ContentSnapshot;
+	TMap<FName, int64> PackageDiskSizes;
+	int64 AllAssetsSize;
+	int64 UnusedAssetsSize;
+
+	/* Dependency Graph of game packages (built once per analysis) */
+	FProjectCleanerDependencyGraph DependencyGraph;
+	/* Graph node of every asset in AllAssets */
+	TArray<int32> AssetNodes;
+	/* Nodes of packages deleted since graph was built, their edges still in graph */
+	TBitArray<> RemovedNodes;
+	/* For every used node - node it was reached from and why root of it is used */
+	TArray<int32> UsedNodeParents;
+	TArray<EProjectCleanerUsedAssetRoot> UsedNodeRoots;
+	FProjectCleanerDominatorTree DominatorTree;
+	/* Roots of dominator tree sorted by retained size, largest first */
+	TArray<FAssetData> LargestUnusedRoots;
+	TArray<FAssetData> LargestUsedRoots;
+
+	/* Indirect references of source and config files (loaded from disk on first analysis) */
+	FProjectCleanerIndirectCache IndirectCache;
+	bool bIndirectCacheLoaded;
 
 	/* Configs */
 	bool bSilentMode;
 	bool bScanDeveloperContents;
 	bool bAutomaticallyDeleteEmptyFolders;
+	bool bForceSerialTraversal;
+	bool bDeleteWithoutLoading;
+	int64 DeletionMemoryLimit;
+	EProjectCleanerDependencyType FollowedDependencyTypes;
 	TSet<FName> ExcludedPaths;
 	TSet<FName> ExcludedClasses;
 	bool bCancelledByUser;
@@ -0,0 +1,66 @@
+﻿// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+#pragma once
+
+// Engine Headers
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+
+/**
+ * Write ahead journal of unused assets deletion, placed in Saved/ProjectCleaner/.
+ * Deletion plan written once before first bucket, then every finished bucket appended as single line and flushed,
+ * so if editor crashes in the middle of deletion, it can be resumed from last committed bucket.
+ * Assets held back by bucket validation recorded separately, because they deleted after all buckets and out of plan order.
+ * Journal removed only when whole plan processed, cancelled or aborted deletion keeps it, so it can be resumed too
+ */
+class PROJECTCLEANER_API FProjectCleanerDeletionJournal
+{
+public:
+	~FProjectCleanerDeletionJournal();
+	
+	/**
+	 * @brief Creates new journal with given deletion plan, replacing old one
+	 * @param PlannedAssets Assets in deletion order
+	 * @return false if journal file can't be written
+	 */
+	bool Begin(const TArray<FAssetData>& PlannedAssets);
+
+	/**
+	 * @brief Appends record of finished bucket
+	 * @param NumAssets Number of planned assets processed in bucket
+	 */
+	void CommitBucket(const int32 NumAssets);
+
+	/**
+	 * @brief Appends assets that held back from their bucket, must be called before committing that bucket
+	 * @param Assets Held assets
+	 */
+	void HoldAssets(const TArray<FAssetData>& Assets);
+
+	/**
+	 * @brief Appends record of processed held assets
+	 * @param Assets Held assets processed in bucket
+	 */
+	void CommitHeldAssets(const TArray<FAssetData>& Assets);
+
+	/**
+	 * @brief Closes and removes journal
+	 */
+	void Finish();
+
+	/**
+	 * @brief Reads journal left by interrupted deletion
+	 * @param OutRemainingAssets Object paths of planned assets that are not in committed buckets, in deletion order, followed by held assets that are not processed
+	 * @return false if there is no valid journal
+	 */
+	static bool LoadRemainingAssets(TArray<FName>& OutRemainingAssets);
+	static bool Exists();
+	static void Discard();
+	static FString GetJournalFilePath();
+
+private:
+	void WriteLine(const FString& Line);
+	void WriteAssets(const TCHAR* Prefix, const TArray<FAssetData>& Assets);
+	
+	TUniquePtr<FArchive> Writer;
+};
@@ -0,0 +1,47 @@
+﻿// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+#pragma once
+
+// Engine Headers
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+#include "Core/ProjectCleanerDependencyGraph.h"
+
+/**
+ * Deletion order of unused assets, computed once from dependency graph.
+ * Assets grouped into strongly connected components ordered referencers first, so every bucket consists of whole components,
+ * and assets in bucket referenced only by assets in same bucket or already deleted buckets. Buckets emitted in O(V + E) total.
+ */
+class PROJECTCLEANER_API FProjectCleanerDeletionPlanner
+{
+public:
+	/**
+	 * @brief Computes deletion order of given assets
+	 * @param Graph Dependency graph
+	 * @param Assets Assets to delete
+	 */
+	void Build(const FProjectCleanerDependencyGraph& Graph, const TArray<FAssetData>& Assets);
+	void Reset();
+
+	/**
+	 * @brief Takes next components from plan, until bucket reaches given size. Component bigger than bucket emitted alone
+	 * @param MaxAssets Max number of assets in bucket
+	 * @param OutBucket Assets to delete, replaced
+	 * @return false if plan is finished
+	 */
+	bool GetNextBucket(const int32 MaxAssets, TArray<FAssetData>& OutBucket);
+
+	/**
+	 * @brief All planned assets in deletion order, buckets are consecutive ranges of it
+	 * @return Assets
+	 */
+	const TArray<FAssetData>& GetOrderedAssets() const;
+	bool IsFinished() const;
+
+private:
+	/* Assets in deletion order */
+	TArray<FAssetData> OrderedAssets;
+	/* Component C contains assets [ComponentEnds[C - 1], ComponentEnds[C]) */
+	TArray<int32> ComponentEnds;
+	int32 NextComponent = 0;
+};
@@ -0,0 +1,134 @@
+﻿// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+#pragma once
+
+// Engine Headers
+#include "CoreMinimal.h"
+
+class IAssetRegistry;
+
+/** Type of dependency edge. Edge can have multiple types, when packages depend on each other in multiple ways */
+enum class EProjectCleanerDependencyType : uint8
+{
+	None = 0,
+	Hard = 1 << 0,
+	Soft = 1 << 1,
+	EditorOnlyHard = 1 << 2,
+	EditorOnlySoft = 1 << 3,
+	/* Primary asset management (PrimaryAssetLabel etc.) */
+	Management = 1 << 4,
+	SearchableName = 1 << 5,
+
+	Game = Hard | Soft,
+	EditorOnly = EditorOnlyHard | EditorOnlySoft,
+	Package = Game | EditorOnly,
+	All = Package | Management | SearchableName
+};
+ENUM_CLASS_FLAGS(EProjectCleanerDependencyType);
+
+/**
+ * Snapshot of package dependency graph, stored in compressed sparse row format with dense node ids.
+ * Game packages get ids [0, NumGameNodes), other packages that reference game packages (engine, plugins etc.) placed after.
+ * Built by single pass over asset registry, so all analysis and deletion planning done without registry queries.
+ */
+class PROJECTCLEANER_API FProjectCleanerDependencyGraph
+{
+public:
+	/**
+	 * @brief Replaces graph content with referencers of given packages, taken from asset registry
+	 * @param AssetRegistry Asset registry
+	 * @param GamePackages Package names of game packages, duplicates ignored
+	 */
+	void Build(const IAssetRegistry& AssetRegistry, const TArray<FName>& GamePackages);
+	void Reset();
+
+	int32 GetNumNodes() const;
+	int32 GetNumGameNodes() const;
+	int32 GetNumEdges() const;
+
+	/**
+	 * @brief Counts edges that have any of given types
+	 * @param EdgeTypes Dependency types
+	 * @return int32
+	 */
+	int32 GetNumEdges(const EProjectCleanerDependencyType EdgeTypes) const;
+
+	/* Mount point id of "/Game" */
+	static constexpr int32 GameMountPoint = 0;
+
+	/**
+	 * @brief Checks if node package is under "/Game" mount point. Precomputed for every node, so no string checks needed while traversing
+	 * @param Node Node id
+	 * @return bool
+	 */
+	bool IsGameNode(const int32 Node) const;
+	const FName& GetPackageName(const int32 Node) const;
+
+	/**
+	 * @brief Searches node by package name
+	 * @param PackageName Package name
+	 * @return Node id or INDEX_NONE if package not in graph
+	 */
+	int32 FindNode(const FName& PackageName) const;
+
+	/**
+	 * @brief Nodes that given node depends on. Only game nodes can be dependencies
+	 * @param Node Node id
+	 * @return TArrayView<const int32>
+	 */
+	TArrayView<const int32> GetDependencies(const int32 Node) const;
+	TArrayView<const EProjectCleanerDependencyType> GetDependencyTypes(const int32 Node) const;
+
+	/**
+	 * @brief Nodes that depend on given node
+	 * @param Node Node id
+	 * @return TArrayView<const int32>
+	 */
+	TArrayView<const int32> GetReferencers(const int32 Node) const;
+	TArrayView<const EProjectCleanerDependencyType> GetReferencerTypes(const int32 Node) const;
+
+	/**
+	 * @brief Marks all nodes reachable from given roots by following dependencies.
+	 * Large frontiers are expanded in parallel level by level, result is same as serial search
+	 * @param Roots Start nodes
+	 * @param OutReached Bit per node, set if node reachable (roots included)
+	 * @param EdgeTypes Only edges with any of given types followed
+	 * @param bForceSerial Disables parallel search (for verification)
+	 * @param OutParents Optional, for every reached node - node it was reached from (INDEX_NONE for roots), so following parents gives shortest path to root
+	 */
+	void FindReachableNodes(const TArray<int32>& Roots, TBitArray<>& OutReached, const EProjectCleanerDependencyType EdgeTypes = EProjectCleanerDependencyType::Package, const bool bForceSerial = false, TArray<int32>* OutParents = nullptr) const;
+
+	/**
+	 * @brief Marks nodes that referenced by packages from other mount points, single sweep over all reverse edges
+	 * @param OutNodes Bit per node, set if node has referencer from other mount point
+	 * @param EdgeTypes Only edges with any of given types checked
+	 */
+	void FindNodesWithExternalReferencers(TBitArray<>& OutNodes, const EProjectCleanerDependencyType EdgeTypes = EProjectCleanerDependencyType::Package) const;
+
+	/**
+	 * @brief Groups nodes of subgraph into strongly connected components (Tarjan), edges of all types considered.
+	 * Components ordered referencers first - if any node of component A references node of component B, A placed before B
+	 * @param Nodes Bit per node, set if node belongs to subgraph
+	 * @param OutComponentNodes Nodes of all components, component C placed in range [OutComponentOffsets[C], OutComponentOffsets[C + 1])
+	 * @param OutComponentOffsets Component ranges, number of components is OutComponentOffsets.Num() - 1
+	 */
+	void FindStronglyConnectedComponents(const TBitArray<>& Nodes, TArray<int32>& OutComponentNodes, TArray<int32>& OutComponentOffsets) const;
+
+private:
+	int32 FindOrAddNode(const FName& PackageName);
+	
+	TArray<FName> PackageNames;
+	TMap<FName, int32> NodeByPackageName;
+	/* Mount point id of node package ("/Game", "/Engine", "/<PluginName>" etc.) */
+	TArray<int32> NodeMountPoints;
+	TMap<FName, int32> MountPointIds;
+	int32 NumGameNodes = 0;
+
+	/* Edges of node N placed in range [Offsets[N], Offsets[N + 1]) */
+	TArray<int32> DependencyOffsets;
+	TArray<int32> Dependencies;
+	TArray<EProjectCleanerDependencyType> DependencyTypes;
+	TArray<int32> ReferencerOffsets;
+	TArray<int32> Referencers;
+	TArray<EProjectCleanerDependencyType> ReferencerTypes;
+};
@@ -0,0 +1,40 @@
+﻿// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+#pragma once
+
+// Engine Headers
+#include "CoreMinimal.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+
+/**
+ * Walks directory tree recursively using task graph workers.
+ * Every worker owns queue of pending directories, idle workers steal directories from other workers queues.
+ */
+class PROJECTCLEANER_API FProjectCleanerDirectoryWalker
+{
+public:
+	/**
+	 * @brief Called for every file and directory in walked tree. Called concurrently from different workers.
+	 * @param WorkerIndex Index of worker that visits entry, in range [0, NumWorkers). Can be used to access per worker data without locking.
+	 * @param ParentId Id returned by visitor for parent directory, or RootId for entries directly under walked directory
+	 * @param Path Absolute path of file or directory
+	 * @param StatData Size, timestamps and type of entry
+	 * @return Id of visited directory, will be passed as ParentId when its children visited. Ignored for files.
+	 */
+	using FVisitor = TFunctionRef<int64(const int32 WorkerIndex, const int64 ParentId, const TCHAR* Path, const FFileStatData& StatData)>;
+
+	/**
+	 * @brief Returns number of workers that Walk will use
+	 * @return int32
+	 */
+	static int32 GetNumWorkers();
+
+	/**
+	 * @brief Visits all files and directories under given directory. Returns when whole tree visited.
+	 * @param RootDir Absolute path of directory to walk
+	 * @param RootId Id passed as ParentId for entries directly under RootDir
+	 * @param NumWorkers Number of workers, see GetNumWorkers
+	 * @param Visitor
+	 */
+	static void Walk(const FString& RootDir, const int64 RootId, const int32 NumWorkers, FVisitor Visitor);
+};
@@ -0,0 +1,52 @@
+﻿// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+#pragma once
+
+// Engine Headers
+#include "CoreMinimal.h"
+#include "Core/ProjectCleanerDependencyGraph.h"
+
+/**
+ * Dominator tree of dependency graph. Node A dominates node B, if every path from roots to B goes through A,
+ * so retained size of A is size of everything that will be freed when A deleted (or stops being referenced).
+ * All roots hang under virtual super root. Computed by iterative Cooper-Harvey-Kennedy algorithm, which is near linear on dependency graphs.
+ */
+class PROJECTCLEANER_API FProjectCleanerDominatorTree
+{
+public:
+	/**
+	 * @brief Builds dominator tree over game nodes of given graph.
+	 * Game nodes that can't be reached from roots are covered too, those without referencers become extra roots first, then remaining cycles
+	 * @param Graph Dependency graph
+	 * @param Roots Root nodes
+	 * @param EdgeTypes Only edges with any of given types followed
+	 * @param NodeSizes Size of every node in graph
+	 */
+	void Build(const FProjectCleanerDependencyGraph& Graph, const TArray<int32>& Roots, const EProjectCleanerDependencyType EdgeTypes, const TArray<int64>& NodeSizes);
+	void Reset();
+
+	/**
+	 * @brief Returns immediate dominator of given node
+	 * @param Node Node id
+	 * @return Dominator node id, or INDEX_NONE if node is root (dominated only by super root) or not in tree
+	 */
+	int32 GetImmediateDominator(const int32 Node) const;
+
+	/**
+	 * @brief Returns size of node and all nodes dominated by it
+	 * @param Node Node id
+	 * @return int64
+	 */
+	int64 GetRetainedSize(const int32 Node) const;
+
+	bool IsInTree(const int32 Node) const;
+
+private:
+	int32 Intersect(int32 NodeA, int32 NodeB) const;
+	
+	int32 SuperRoot = INDEX_NONE;
+	/* Indexed by node id, super root placed after graph nodes */
+	TArray<int32> ImmediateDominators;
+	TArray<int32> PostOrderNumbers;
+	TArray<int64> RetainedSizes;
+};
@@ -0,0 +1,83 @@
+﻿// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+#pragma once
+
+// Engine Headers
+#include "CoreMinimal.h"
+
+struct FProjectCleanerFileEntry
+{
+	/* Absolute path */
+	FString Path;
+	int32 DirectoryIndex = INDEX_NONE;
+	int64 Size = 0;
+	FDateTime ModificationTime;
+};
+
+struct FProjectCleanerDirectoryEntry
+{
+	/* Absolute path, without trailing slash */
+	FString Path;
+	int32 ParentIndex = INDEX_NONE;
+	/* Subdirectories placed sequentially, starting from this index */
+	int32 FirstSubDirectoryIndex = INDEX_NONE;
+	int32 NumFiles = 0;
+	int32 NumSubDirectories = 0;
+	/* Number of files in this directory and all its subdirectories */
+	int32 NumFilesRecursive = 0;
+	/* Size of all files in this directory and all its subdirectories */
+	int64 SizeRecursive = 0;
+	FDateTime ModificationTime;
+	/* Deleted after snapshot was built, entry kept so indices stay valid */
+	bool bRemoved = false;
+};
+
+/**
+ * In memory snapshot of all files and directories under given root directory.
+ * Built by single parallel traversal, so all file based analysis can be done without touching file system again.
+ */
+class PROJECTCLEANER_API FProjectCleanerFileSnapshot
+{
+public:
+	/**
+	 * @brief Walks given directory and replaces snapshot content
+	 * @param InRootDir Absolute path of directory
+	 */
+	void Build(const FString& InRootDir);
+	void Reset();
+
+	const FString& GetRootDir() const;
+	const TArray<FProjectCleanerFileEntry>& GetFiles() const;
+
+	/**
+	 * @brief All directories in snapshot in breadth first order. Root directory always has index 0 and parent always placed before its children
+	 * @return Directories
+	 */
+	const TArray<FProjectCleanerDirectoryEntry>& GetDirectories() const;
+
+	/**
+	 * @brief Searches directory by its absolute path
+	 * @param Path Absolute path of directory, with or without trailing slash
+	 * @return Index of directory or INDEX_NONE if its not in snapshot
+	 */
+	int32 FindDirectory(const FString& Path) const;
+
+	/**
+	 * @brief Removes given files from snapshot and updates directory totals, so snapshot matches disk after deletion without walking it again
+	 * @param Paths Absolute paths of removed files
+	 * @param OutEmptiedDirectories Directories that had files before and now have no files recursively
+	 * @return Number of removed files
+	 */
+	int32 RemoveFiles(const TSet<FString>& Paths, TArray<int32>& OutEmptiedDirectories);
+
+	/**
+	 * @brief Marks directory and all its subdirectories as removed
+	 * @param Index Index of directory
+	 */
+	void RemoveDirectory(const int32 Index);
+	
+private:
+	FString RootDir;
+	TArray<FProjectCleanerFileEntry> Files;
+	TArray<FProjectCleanerDirectoryEntry> Directories;
+};
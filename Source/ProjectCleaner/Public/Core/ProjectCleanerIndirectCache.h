@@ -0,0 +1,70 @@
+﻿// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+#pragma once
+
+// Engine Headers
+#include "CoreMinimal.h"
+#include "Core/ProjectCleanerIndirectScanner.h"
+
+struct FProjectCleanerIndirectCacheEntry
+{
+	int64 Size = 0;
+	/* Modification time ticks */
+	int64 ModificationTime = 0;
+	/* Content hash, see FProjectCleanerIndirectScanner::HashBlock */
+	uint64 Hash = 0;
+	TArray<FProjectCleanerIndirectReference> References;
+
+	friend FArchive& operator<<(FArchive& Ar, FProjectCleanerIndirectCacheEntry& Entry);
+};
+
+/**
+ * On disk cache of indirect asset references found in source and config files.
+ * Files are keyed by path, size, modification time and content hash, so unchanged files are not read or scanned again.
+ */
+class PROJECTCLEANER_API FProjectCleanerIndirectCache
+{
+public:
+	/**
+	 * @brief Loads cache from given file, if file missing or has different version, cache stays empty
+	 * @param CacheFilePath Path of cache file
+	 * @return true if cache loaded
+	 */
+	bool Load(const FString& CacheFilePath);
+
+	/**
+	 * @brief Saves cache to given file
+	 * @param CacheFilePath Path of cache file
+	 * @return true if cache saved
+	 */
+	bool Save(const FString& CacheFilePath) const;
+
+	/**
+	 * @brief Fills entry for given file, reusing cached references if file not changed, otherwise scans file. Thread safe.
+	 * @param FilePath Path of file
+	 * @param OutEntry Entry with file key and found references
+	 * @return false if file can't be read
+	 */
+	bool ScanFile(const FString& FilePath, FProjectCleanerIndirectCacheEntry& OutEntry) const;
+
+	/**
+	 * @brief Removes all cached entries
+	 */
+	void Reset();
+
+	/**
+	 * @brief Adds or replaces entry for given file
+	 * @param FilePath Path of file
+	 * @param Entry Entry to cache
+	 */
+	void Add(const FString& FilePath, FProjectCleanerIndirectCacheEntry&& Entry);
+
+	/**
+	 * @brief Returns default cache file path (<yourproject>/Saved/ProjectCleaner/IndirectReferences.bin)
+	 * @return FString
+	 */
+	static FString GetDefaultCacheFilePath();
+	
+private:
+	TMap<FString, FProjectCleanerIndirectCacheEntry> Entries;
+};
@@ -0,0 +1,74 @@
+﻿// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+#pragma once
+
+// Engine Headers
+#include "CoreMinimal.h"
+
+struct FProjectCleanerIndirectReference
+{
+	/* Path as written in file, for example "/Game/Maps/Main.Main" */
+	FString Path;
+	int32 Line = 0;
+};
+
+/**
+ * Searches asset paths (like "/Game/Maps/Main.Main") used in source code, config or other text files.
+ * Works directly on raw UTF-8 bytes in single pass, tracking line numbers while searching.
+ * Files are memory mapped when platform supports it, otherwise streamed through fixed size buffer, so whole file never copied to memory.
+ */
+class PROJECTCLEANER_API FProjectCleanerIndirectScanner
+{
+public:
+	/**
+	 * @brief Scans given file and appends all found asset paths
+	 * @param FilePath Path of file
+	 * @param OutReferences Found asset paths with line numbers
+	 * @param OutContentHash Optional, hash of file content (see HashBlock)
+	 * @return false if file can't be read
+	 */
+	static bool ScanFile(const FString& FilePath, TArray<FProjectCleanerIndirectReference>& OutReferences, uint64* OutContentHash = nullptr);
+
+	/**
+	 * @brief Scans given file content and appends all found asset paths, UTF-16 content converted to UTF-8 first
+	 * @param Data File bytes
+	 * @param Size Number of bytes
+	 * @param OutReferences Found asset paths with line numbers
+	 */
+	static void ScanContent(const uint8* Data, const int64 Size, TArray<FProjectCleanerIndirectReference>& OutReferences);
+
+	/**
+	 * @brief Scans given UTF-8 text and appends all found asset paths
+	 * @param Data Text bytes
+	 * @param Size Number of bytes
+	 * @param OutReferences Found asset paths with line numbers
+	 * @param FirstLine Line number of first byte in buffer
+	 */
+	static void ScanBuffer(const uint8* Data, const int64 Size, TArray<FProjectCleanerIndirectReference>& OutReferences, const int32 FirstLine = 1);
+
+	/**
+	 * @brief Content hash is chained CityHash64 over fixed size blocks, so same value computed for mapped and streamed files
+	 * @param Data Block bytes, BlockSize bytes or less for last block
+	 * @param Size Number of bytes
+	 * @param Hash Hash of previous blocks (0 for first block)
+	 * @return uint64
+	 */
+	static uint64 HashBlock(const uint8* Data, const int64 Size, const uint64 Hash);
+
+	/**
+	 * @brief Computes content hash of given file without scanning it
+	 * @param FilePath Path of file
+	 * @param OutContentHash Hash of file content (see HashBlock)
+	 * @return false if file can't be read
+	 */
+	static bool HashFile(const FString& FilePath, uint64& OutContentHash);
+
+	static constexpr int64 BlockSize = 1024 * 1024;
+
+private:
+	static bool ScanMappedFile(const FString& FilePath, TArray<FProjectCleanerIndirectReference>& OutReferences, uint64* OutContentHash);
+	static bool ScanStreamedFile(const FString& FilePath, TArray<FProjectCleanerIndirectReference>& OutReferences, uint64* OutContentHash);
+	static bool IsUTF16(const uint8* Data, const int64 Size);
+	static bool IsPathChar(const uint8 Char);
+	static int32 CountLines(const uint8* Begin, const uint8* End);
+};
@@ -5,7 +5,7 @@
 #include "CoreMinimal.h"
 #include "Core/ProjectCleanerDataManager.h"
 
-struct FIndirectAsset;
+struct FIndirectAssets;
 class UCleanerConfigs;
 class FAssetRegistryModule;
 
@@ -19,6 +19,11 @@ public:
 
 	// UI actions
 	void Update();
+
+	/**
+	 * @brief Asks to resume or discard deletion interrupted in previous session. Asked only first time it called
+	 */
+	void CheckInterruptedDeletion();
 	virtual void ExcludeSelectedAssets(const TArray<FAssetData>& Assets) override;
 	virtual void ExcludeSelectedAssetsByType(const TArray<FAssetData>& Assets) override;
 	virtual bool ExcludePath(const FString& InPath) override;
@@ -28,6 +33,8 @@ public:
 	virtual int32 DeleteSelectedAssets(const TArray<FAssetData>& Assets) override;
 	virtual int32 DeleteAllUnusedAssets() override;
 	virtual int32 DeleteEmptyFolders() override;
+	int32 QuarantineAllUnusedAssets();
+	int32 RestoreLatestQuarantine();
 
 	// getters
 	const FProjectCleanerDataManager& GetDataManager() const;
@@ -36,9 +43,15 @@ public:
 	const TSet<FName>& GetExcludedAssets() const;
 	const TSet<FName>& GetCorruptedAssets() const;
 	const TSet<FName>& GetNonEngineFiles() const;
-	const TMap<FAssetData, FIndirectAsset>& GetIndirectAssets() const;
+	const FIndirectAssets& GetIndirectAssets() const;
+	const TArray<FAssetData>& GetEditorOnlyUsedAssets() const;
 	const TSet<FName>& GetEmptyFolders() const;
 	const TSet<FName>& GetPrimaryAssetClasses() const;
+	int64 GetAllAssetsSize() const;
+	int64 GetUnusedAssetsSize() const;
+	int64 GetRetainedSize(const FAssetData& Asset) const;
+	const TArray<FAssetData>& GetLargestUnusedRoots() const;
+	bool GetUsageChain(const FAssetData& Asset, TArray<FName>& OutChain, EProjectCleanerUsedAssetRoot& OutRoot) const;
 	UCleanerConfigs* GetCleanerConfigs() const;
 	float GetUnusedAssetsPercent() const;
 
@@ -47,6 +60,9 @@ public:
 	 */
 	FOnCleanerManagerUpdated OnCleanerManagerUpdated;
 private:
+	int32 DeleteEmptyFolders(const bool bRescanContent);
+	
 	class UCleanerConfigs* CleanerConfigs;
+	bool bInterruptedDeletionChecked = false;
 	FProjectCleanerDataManager DataManager;
 };
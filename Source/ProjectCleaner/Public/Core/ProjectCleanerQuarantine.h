@@ -0,0 +1,42 @@
+﻿// Copyright 2021. Ashot Barkhudaryan. All Rights Reserved.
+
+#pragma once
+
+// Engine Headers
+#include "CoreMinimal.h"
+
+/**
+ * Restorable trash area for package files, placed in Saved/ProjectCleaner/Quarantine/<timestamp>/.
+ * Files moved with their project relative paths, so restore just moves them back.
+ * Every quarantine folder contains manifest, written before any file moved, so interrupted quarantine can be restored too.
+ * Files moved on disk only, source control is not notified, so moved files show up as missing until restored or deleted there
+ */
+class PROJECTCLEANER_API FProjectCleanerQuarantine
+{
+public:
+	/**
+	 * @brief Moves given files into new quarantine folder in single pass
+	 * @param Files Absolute paths of files under project directory
+	 * @param OutQuarantineDir Created quarantine folder
+	 * @return Absolute paths of files that were moved (original locations)
+	 */
+	static TArray<FString> MoveToQuarantine(const TArray<FString>& Files, FString& OutQuarantineDir);
+
+	/**
+	 * @brief Moves files of given quarantine folder back to their original locations and removes folder
+	 * @param QuarantineDir Quarantine folder
+	 * @return Absolute paths of restored files
+	 */
+	static TArray<FString> Restore(const FString& QuarantineDir);
+
+	/**
+	 * @brief Returns all quarantine folders, oldest first
+	 * @param OutQuarantineDirs Absolute paths of quarantine folders
+	 */
+	static void GetQuarantineDirs(TArray<FString>& OutQuarantineDirs);
+	static FString GetLatestQuarantineDir();
+	static FString GetQuarantineRootDir();
+
+private:
+	static FString GetManifestFilePath(const FString& QuarantineDir);
+};
@@ -24,11 +24,9 @@ public:
 	static void SaveAllAssets(const bool PromptUser);
 	static void UpdateAssetRegistry(bool bSyncScan);
 	static void FocusOnGameFolder();
-	static bool FindEmptyFoldersInPath(const FString& FolderPath, TSet<FName>& EmptyFolders);
 	static int32 DeleteAssets(TArray<FAssetData>& Assets, const bool ForceDelete);
 	static bool IsEngineExtension(const FString& Extension);
 	static bool IsUnderMegascansFolder(const FAssetData& AssetData);
-	static bool HasIndirectlyUsedAssets(const FString& FileContent);
 private:
 	static FString ConvertPathInternal(const FString& From, const FString To, const FString& Path);
 };
\ No newline at end of file
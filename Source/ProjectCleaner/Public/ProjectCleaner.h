@@ -9,6 +9,8 @@
 
 DECLARE_LOG_CATEGORY_EXTERN(LogProjectCleaner, Log, All);
 
+class FExtender;
+
 class FProjectCleanerModule : public IModuleInterface
 {
 public:
@@ -20,10 +22,13 @@ private:
 	/* Module */
 	void RegisterMenus();
 	void PluginButtonClicked();
+	TSharedRef<FExtender> OnExtendAssetContextMenu(const TArray<FAssetData>& SelectedAssets);
+	void ShowUsageChain(const FAssetData Asset);
 	TSharedRef<SDockTab> OnSpawnPluginTab(const FSpawnTabArgs& SpawnTabArgs);
 	
 	/* UI data */
 	TSharedPtr<FUICommandList> PluginCommands;
+	FDelegateHandle AssetContextMenuExtenderHandle;
 
 	/* Cleaner Manager */
 	class FProjectCleanerManager CleanerManager;
@@ -33,6 +33,24 @@ public:
 
 	UPROPERTY(DisplayName = "Delete Empty Folders After Assets Deleted", EditAnywhere, Category = "CleanerConfigs")
 	bool bAutomaticallyDeleteEmptyFolders = true;
+
+	UPROPERTY(DisplayName = "Soft References", EditAnywhere, Category = "CleanerConfigs|Dependencies", meta = (ToolTip = "Assets referenced by soft references are used. By Default true"))
+	bool bFollowSoftReferences = true;
+
+	UPROPERTY(DisplayName = "Editor Only References", EditAnywhere, Category = "CleanerConfigs|Dependencies", meta = (ToolTip = "Assets referenced only in editor (not cooked) are used. By Default true"))
+	bool bFollowEditorOnlyReferences = true;
+
+	UPROPERTY(DisplayName = "Management References", EditAnywhere, Category = "CleanerConfigs|Dependencies", meta = (ToolTip = "Assets managed by primary assets (PrimaryAssetLabel etc.) are used. By Default false"))
+	bool bFollowManagementReferences = false;
+
+	UPROPERTY(DisplayName = "Searchable Name References", EditAnywhere, Category = "CleanerConfigs|Dependencies", meta = (ToolTip = "Assets referenced by searchable names (gameplay tags, data table rows etc.) are used. By Default false"))
+	bool bFollowSearchableNameReferences = false;
+
+	UPROPERTY(DisplayName = "Delete Without Loading", EditAnywhere, Category = "CleanerConfigs|Deletion", meta = (ToolTip = "Assets that are not loaded and have no loaded referencers deleted as package files (through source control if enabled), without loading them. Much faster for large amount of textures, materials etc. By Default false"))
+	bool bDeleteWithoutLoading = false;
+
+	UPROPERTY(DisplayName = "Memory Limit (MB)", EditAnywhere, Category = "CleanerConfigs|Deletion", meta = (ClampMin = "1024", ToolTip = "Editor memory usage limit while deleting assets. Bucket size adapted to stay under limit and garbage collected when usage gets close to it. By Default 16384"))
+	int32 DeletionMemoryLimitMB = 16384;
 	
 	UPROPERTY(DisplayName = "Paths", EditAnywhere, Category = "CleanerConfigs|ExcludeOptions", meta = (ContentDir))
 	TArray<FDirectoryPath> Paths;
@@ -85,13 +103,49 @@ public:
 	FString FilePath;
 };
 
-struct FIndirectAsset
+/* Reason why asset is used root */
+enum class EProjectCleanerUsedAssetRoot : uint8
 {
-	FString File;
+	None,
+	PrimaryAsset,
+	IndirectReference,
+	ExternalReferencer,
+	DeveloperFolder,
+	Excluded
+};
+
+struct FIndirectAssetUsage
+{
+	/* Index in FIndirectAssets::Files */
+	int32 FileIndex;
 	int32 Line;
-	FName RelativePath;
 
-	FIndirectAsset(): File(FString{}), Line(0), RelativePath(NAME_None) {}
+	FIndirectAssetUsage(): FileIndex(INDEX_NONE), Line(0) {}
+	FIndirectAssetUsage(const int32 InFileIndex, const int32 InLine): FileIndex(InFileIndex), Line(InLine) {}
+
+	bool operator==(const FIndirectAssetUsage& Other) const
+	{
+		return FileIndex == Other.FileIndex && Line == Other.Line;
+	}
+};
+
+struct FIndirectAssets
+{
+	/* Absolute paths of files where assets used, every file stored once */
+	TArray<FString> Files;
+	/* All usages for every indirectly used asset, keyed by asset index in AllAssets */
+	TMap<int32, TArray<FIndirectAssetUsage>> Usages;
+
+	int32 Num() const
+	{
+		return Usages.Num();
+	}
+
+	void Reset()
+	{
+		Files.Reset();
+		Usages.Reset();
+	}
 };
 
 struct FStandardCleanerText
@@ -103,6 +157,15 @@ struct FStandardCleanerText
 	constexpr static TCHAR* DeletingUnusedAssets = TEXT("Deleting unused assets...");
 	constexpr static TCHAR* DeletingEmptyFolders = TEXT("Deleting empty folders...");
 	constexpr static TCHAR* NoAssetsToDelete = TEXT("There are no assets to delete!");
+	constexpr static TCHAR* AssetsQuarantineWindowTitle = TEXT("Confirm quarantine");
+	constexpr static TCHAR* AssetsQuarantineWindowContent = TEXT("Move unused assets to quarantine folder? They can be restored later.");
+	constexpr static TCHAR* QuarantineRestoreWindowTitle = TEXT("Confirm restore");
+	constexpr static TCHAR* QuarantineRestoreWindowContent = TEXT("Restore assets from last quarantine?");
+	constexpr static TCHAR* QuarantiningUnusedAssets = TEXT("Moving unused assets to quarantine...");
+	constexpr static TCHAR* NoQuarantineToRestore = TEXT("There is no quarantine to restore!");
+	constexpr static TCHAR* UnusedAssetsSuccessfullyQuarantined = TEXT("Unused assets moved to quarantine successfully");
+	constexpr static TCHAR* FailedToQuarantineSomeAssets = TEXT("Failed to move some assets to quarantine. Open 'Output Log' for more information.");
+	constexpr static TCHAR* QuarantineSuccessfullyRestored = TEXT("Quarantined assets restored successfully");
 	constexpr static TCHAR* NoEmptyFolderToDelete = TEXT("There are no empty folders to delete!");
 	constexpr static TCHAR* AssetRegistryStillWorking = TEXT("Please wait, AssetRegistry is loading assets");
 	constexpr static TCHAR* CantIncludeSomeAssets = TEXT("Cant include selected assets, because they are excluded by 'Exclude Options' filter.");
@@ -117,6 +180,8 @@ struct FStandardCleanerText
 	constexpr static TCHAR* FixingUpRedirectors = TEXT("Fixing up redirectors...");
 	constexpr static TCHAR* AnalyzingAssets = TEXT("Analyzing unused assets...");
 	constexpr static TCHAR* PreparingAssetsForDeletion = TEXT("Preparing assets for deletion...");
+	constexpr static TCHAR* ResumeDeletionTitle = TEXT("Resume interrupted cleanup");
+	constexpr static TCHAR* ResumeDeletionContent = TEXT("Previous deletion of unused assets was interrupted. Resume it from last finished bucket?");
 	constexpr static TCHAR* RestartEditorTitle = TEXT("Confirm Restart Editor");
 	constexpr static TCHAR* RestartEditorContent = TEXT("To finish project cleaning,its recommended to Restart Editor. Proceed?");
 };
\ No newline at end of file
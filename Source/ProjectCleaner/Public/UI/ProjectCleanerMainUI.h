@@ -36,6 +36,8 @@ private:
 	FReply OnRefreshBtnClick() const;
 	FReply OnDeleteUnusedAssetsBtnClick() const;
 	FReply OnDeleteEmptyFolderClick() const;
+	FReply OnQuarantineUnusedAssetsBtnClick() const;
+	FReply OnRestoreQuarantineBtnClick() const;
 	
 	/* UI Data */
 	TWeakPtr<class SProjectCleanerStatisticsUI> StatisticsUI;
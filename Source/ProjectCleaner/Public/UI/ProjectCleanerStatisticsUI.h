@@ -22,8 +22,10 @@ private:
 	FText GetUnusedAssetsNum() const;
 	FText GetTotalProjectSize() const;
 	FText GetTotalUnusedAssetsSize() const;
+	FText GetLargestUnusedRoot() const;
 	FText GetNonEngineFilesNum() const;
 	FText GetIndirectAssetsNum() const;
+	FText GetEditorOnlyUsedAssetsNum() const;
 	FText GetEmptyFoldersNum() const;
 	FText GetCorruptedAssetsNum() const;
 	FText GetExcludedAssetsNum() const;